@@ -15,8 +15,6 @@
 
 #include $(TMK_PATH)/protocol.mk
 
-TEST_PATH=tests/$(TEST)
-
 $(TEST)_SRC= \
 	$(TEST_PATH)/keymap.c \
 	$(TMK_COMMON_SRC) \
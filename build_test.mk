@@ -48,7 +48,11 @@ CONSOLE_ENABLE = yes
 endif
 
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
-include tests/$(TEST)/rules.mk
+# The variants of the rgb_matrix tests are built from its directory, with their own defines
+include tests/rgb_matrix/testlist.mk
+TEST_PATH := $(or $($(TEST)_TEST_PATH),tests/$(TEST))
+OPT_DEFS += $($(TEST)_OPT_DEFS)
+include $(TEST_PATH)/rules.mk
 endif
 
 include common_features.mk
@@ -57,6 +61,8 @@ include $(QUANTUM_PATH)/debounce/tests/rules.mk
 include $(QUANTUM_PATH)/sequencer/tests/rules.mk
 include $(QUANTUM_PATH)/serial_link/tests/rules.mk
 include $(TMK_PATH)/common/test/rules.mk
+include $(LIB_PATH)/lib8tion/tests/rules.mk
+include $(DRIVER_PATH)/led/issi/tests/rules.mk
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include build_full_test.mk
 endif
@@ -253,6 +253,7 @@ endif
     SRC += $(QUANTUM_DIR)/process_keycode/process_backlight.c
     SRC += $(QUANTUM_DIR)/led_matrix/led_matrix.c
     SRC += $(QUANTUM_DIR)/led_matrix/led_matrix_drivers.c
+    LIGHTING_CORE := yes
     SRC += $(LIB_PATH)/lib8tion/lib8tion.c
     CIE1931_CURVE := yes
 
@@ -282,6 +283,7 @@ endif
     SRC += $(QUANTUM_DIR)/color.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_drivers.c
+    LIGHTING_CORE := yes
     SRC += $(LIB_PATH)/lib8tion/lib8tion.c
     CIE1931_CURVE := yes
     RGB_KEYCODES_ENABLE := yes
@@ -432,15 +434,56 @@ ifeq ($(strip $(WS2812_DRIVER_REQUIRED)), yes)
     endif
 endif
 
+VALID_APA102_DRIVER_TYPES := bitbang spi
+
+APA102_DRIVER ?= bitbang
 ifeq ($(strip $(APA102_DRIVER_REQUIRED)), yes)
+    ifeq ($(filter $(APA102_DRIVER),$(VALID_APA102_DRIVER_TYPES)),)
+        $(error APA102_DRIVER="$(APA102_DRIVER)" is not a valid APA102 driver)
+    endif
+
+    OPT_DEFS += -DAPA102_DRIVER_$(strip $(shell echo $(APA102_DRIVER) | tr '[:lower:]' '[:upper:]'))
+
     COMMON_VPATH += $(DRIVER_PATH)/led
     SRC += apa102.c
+
+    ifeq ($(strip $(APA102_DRIVER)), spi)
+        QUANTUM_LIB_SRC += spi_master.c
+    endif
 endif
 
 ifeq ($(strip $(VISUALIZER_ENABLE)), yes)
     CIE1931_CURVE := yes
 endif
 
+ifeq ($(strip $(LIGHTING_CORE)), yes)
+    COMMON_VPATH += $(QUANTUM_DIR)/lighting
+    SRC += $(QUANTUM_DIR)/lighting/lighting.c
+endif
+
+VALID_RANDOM_DRIVER_TYPES := xorshift adc rng custom
+
+RANDOM_DRIVER ?= xorshift
+ifeq ($(strip $(RANDOM_ENABLE)), yes)
+    ifeq ($(filter $(RANDOM_DRIVER),$(VALID_RANDOM_DRIVER_TYPES)),)
+        $(error RANDOM_DRIVER="$(RANDOM_DRIVER)" is not a valid random driver)
+    endif
+
+    OPT_DEFS += -DRANDOM_ENABLE
+    OPT_DEFS += -DRANDOM_DRIVER_$(strip $(shell echo $(RANDOM_DRIVER) | tr '[:lower:]' '[:upper:]'))
+    SRC += $(QUANTUM_DIR)/random.c
+
+    ifeq ($(strip $(RANDOM_DRIVER)), rng)
+        SRC += random_rng.c
+    else ifneq ($(strip $(RANDOM_DRIVER)), custom)
+        COMMON_VPATH += $(DRIVER_PATH)/random
+        SRC += random_xorshift.c
+        ifeq ($(strip $(RANDOM_DRIVER)), adc)
+            SRC += analog.c
+        endif
+    endif
+endif
+
 ifeq ($(strip $(CIE1931_CURVE)), yes)
     OPT_DEFS += -DUSE_CIE1931_CURVE
     LED_TABLES := yes
@@ -18,40 +18,65 @@
 #include "apa102.h"
 #include "quantum.h"
 
-#ifndef APA102_NOPS
-#    if defined(__AVR__)
-#        define APA102_NOPS 0  // AVR at 16 MHz already spends 62.5 ns per clock, so no extra delay is needed
-#    elif defined(PROTOCOL_CHIBIOS)
-
-#        include "hal.h"
-#        if defined(STM32F0XX) || defined(STM32F1XX) || defined(STM32F3XX) || defined(STM32F4XX) || defined(STM32L0XX)
-#            define APA102_NOPS (100 / (1000000000L / (STM32_SYSCLK / 4)))  // This calculates how many loops of 4 nops to run to delay 100 ns
+#ifdef APA102_DRIVER_SPI
+#    include "spi_master.h"
+
+// spi_master needs a chip select, which the LEDs themselves ignore
+#    ifndef APA102_SPI_SELECT_PIN
+#        error "APA102_DRIVER = spi needs a free pin for spi_master to toggle as chip select, please define APA102_SPI_SELECT_PIN"
+#    endif
+#    ifndef APA102_SPI_DIVISOR
+#        define APA102_SPI_DIVISOR 16
+#    endif
+#    ifndef APA102_LED_COUNT
+#        ifdef RGBLED_NUM
+#            define APA102_LED_COUNT RGBLED_NUM
 #        else
-#            error("APA102_NOPS configuration required")
-#            define APA102_NOPS 0  // this just pleases the compile so the above error is easier to spot
+#            define APA102_LED_COUNT DRIVER_LED_TOTAL
 #        endif
 #    endif
-#endif
 
-#define io_wait                                 \
-    do {                                        \
-        for (int i = 0; i < APA102_NOPS; i++) { \
-            __asm__ volatile("nop\n\t"          \
-                             "nop\n\t"          \
-                             "nop\n\t"          \
-                             "nop\n\t");        \
-        }                                       \
-    } while (0)
-
-#define APA102_SEND_BIT(byte, bit)               \
-    do {                                         \
-        writePin(RGB_DI_PIN, (byte >> bit) & 1); \
-        io_wait;                                 \
-        writePinHigh(RGB_CI_PIN);                \
-        io_wait;                                 \
-        writePinLow(RGB_CI_PIN);                 \
-        io_wait;                                 \
-    } while (0)
+// Start frame, four bytes per LED and the end frame described in apa102_end_frame()
+#    define APA102_FRAME_SIZE(num_leds) (4 + 4 * (num_leds) + ((num_leds) + 14) / 16)
+
+static uint8_t  apa102_frame[APA102_FRAME_SIZE(APA102_LED_COUNT)];
+static uint16_t apa102_frame_length;
+#else
+#    ifndef APA102_NOPS
+#        if defined(__AVR__)
+#            define APA102_NOPS 0  // AVR at 16 MHz already spends 62.5 ns per clock, so no extra delay is needed
+#        elif defined(PROTOCOL_CHIBIOS)
+
+#            include "hal.h"
+#            if defined(STM32F0XX) || defined(STM32F1XX) || defined(STM32F3XX) || defined(STM32F4XX) || defined(STM32L0XX)
+#                define APA102_NOPS (100 / (1000000000L / (STM32_SYSCLK / 4)))  // This calculates how many loops of 4 nops to run to delay 100 ns
+#            else
+#                error("APA102_NOPS configuration required")
+#                define APA102_NOPS 0  // this just pleases the compile so the above error is easier to spot
+#            endif
+#        endif
+#    endif
+
+#    define io_wait                                 \
+        do {                                        \
+            for (int i = 0; i < APA102_NOPS; i++) { \
+                __asm__ volatile("nop\n\t"          \
+                                 "nop\n\t"          \
+                                 "nop\n\t"          \
+                                 "nop\n\t");        \
+            }                                       \
+        } while (0)
+
+#    define APA102_SEND_BIT(byte, bit)               \
+        do {                                         \
+            writePin(RGB_DI_PIN, (byte >> bit) & 1); \
+            io_wait;                                 \
+            writePinHigh(RGB_CI_PIN);                \
+            io_wait;                                 \
+            writePinLow(RGB_CI_PIN);                 \
+            io_wait;                                 \
+        } while (0)
+#endif
 
 uint8_t apa102_led_brightness = APA102_DEFAULT_BRIGHTNESS;
 
@@ -62,6 +87,10 @@ void static apa102_send_frame(uint8_t red, uint8_t green, uint8_t blue, uint8_t
 void static apa102_send_byte(uint8_t byte);
 
 void apa102_setleds(LED_TYPE *start_led, uint16_t num_leds) {
+#ifdef APA102_DRIVER_SPI
+    // The frame buffer only has room for APA102_LED_COUNT
+    if (num_leds > APA102_LED_COUNT) num_leds = APA102_LED_COUNT;
+#endif
     LED_TYPE *end = start_led + num_leds;
 
     apa102_start_frame();
@@ -74,6 +103,24 @@ void apa102_setleds(LED_TYPE *start_led, uint16_t num_leds) {
 // Overwrite the default rgblight_call_driver to use apa102 driver
 void rgblight_call_driver(LED_TYPE *start_led, uint8_t num_leds) { apa102_setleds(start_led, num_leds); }
 
+#ifdef APA102_DRIVER_SPI
+void static apa102_init(void) {
+    static bool is_initialised = false;
+    if (!is_initialised) {
+        is_initialised = true;
+        spi_init();
+    }
+    apa102_frame_length = 0;
+}
+
+// The whole frame goes out in one transfer, which spi_master hands to DMA where the platform has it
+void static apa102_flush(void) {
+    if (spi_start(APA102_SPI_SELECT_PIN, false, 0, APA102_SPI_DIVISOR)) {
+        spi_transmit(apa102_frame, apa102_frame_length);
+    }
+    spi_stop();
+}
+#else
 void static apa102_init(void) {
     setPinOutput(RGB_DI_PIN);
     setPinOutput(RGB_CI_PIN);
@@ -81,6 +128,7 @@ void static apa102_init(void) {
     writePinLow(RGB_DI_PIN);
     writePinLow(RGB_CI_PIN);
 }
+#endif
 
 void apa102_set_brightness(uint8_t brightness) {
     if (brightness > APA102_MAX_BRIGHTNESS) {
@@ -136,9 +184,16 @@ void static apa102_end_frame(uint16_t num_leds) {
         apa102_send_byte(0);
     }
 
+#ifdef APA102_DRIVER_SPI
+    apa102_flush();
+#else
     apa102_init();
+#endif
 }
 
+#ifdef APA102_DRIVER_SPI
+void static apa102_send_byte(uint8_t byte) { apa102_frame[apa102_frame_length++] = byte; }
+#else
 void static apa102_send_byte(uint8_t byte) {
     APA102_SEND_BIT(byte, 7);
     APA102_SEND_BIT(byte, 6);
@@ -149,3 +204,4 @@ void static apa102_send_byte(uint8_t byte) {
     APA102_SEND_BIT(byte, 1);
     APA102_SEND_BIT(byte, 0);
 }
+#endif
@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "aw20216.h"
 #include "spi_master.h"
 
@@ -57,32 +58,34 @@
 #    define AW_SPI_DIVISOR 4
 #endif
 
-uint8_t g_pwm_buffer[DRIVER_COUNT][AW_PWM_REGISTER_COUNT];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+// The command and register bytes sit in front of the registers, so a whole page goes out in a single transfer
+#define AW_FRAME_HEADER_SIZE 2
 
-bool AW20216_write(pin_t cs_pin, uint8_t page, uint8_t reg, uint8_t* data, uint8_t len) {
-    static uint8_t s_spi_transfer_buffer[2] = {0};
+uint8_t g_pwm_buffer[DRIVER_COUNT][AW_FRAME_HEADER_SIZE + AW_PWM_REGISTER_COUNT];
+bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 
+static bool AW20216_transmit(pin_t cs_pin, uint8_t* frame, uint16_t len) {
     if (!spi_start(cs_pin, false, 0, AW_SPI_DIVISOR)) {
         spi_stop();
         return false;
     }
 
-    s_spi_transfer_buffer[0] = (AWINIC_ID | page | AW_WRITE);
-    s_spi_transfer_buffer[1] = reg;
+    bool success = spi_transmit(frame, len) == SPI_STATUS_SUCCESS;
+    spi_stop();
+    return success;
+}
 
-    if (spi_transmit(s_spi_transfer_buffer, 2) != SPI_STATUS_SUCCESS) {
-        spi_stop();
-        return false;
-    }
+static inline void AW20216_frame_header(uint8_t* frame, uint8_t page, uint8_t reg) {
+    frame[0] = (AWINIC_ID | page | AW_WRITE);
+    frame[1] = reg;
+}
 
-    if (spi_transmit(data, len) != SPI_STATUS_SUCCESS) {
-        spi_stop();
-        return false;
-    }
+bool AW20216_write(pin_t cs_pin, uint8_t page, uint8_t reg, uint8_t* data, uint8_t len) {
+    static uint8_t s_spi_transfer_buffer[AW_FRAME_HEADER_SIZE + AW_PWM_REGISTER_COUNT];
 
-    spi_stop();
-    return true;
+    AW20216_frame_header(s_spi_transfer_buffer, page, reg);
+    memcpy(s_spi_transfer_buffer + AW_FRAME_HEADER_SIZE, data, len);
+    return AW20216_transmit(cs_pin, s_spi_transfer_buffer, AW_FRAME_HEADER_SIZE + len);
 }
 
 static inline bool AW20216_write_register(pin_t cs_pin, uint8_t page, uint8_t reg, uint8_t value) {
@@ -92,9 +95,10 @@ static inline bool AW20216_write_register(pin_t cs_pin, uint8_t page, uint8_t re
 
 static void AW20216_init_scaling(pin_t cs_pin) {
     // Set constant current to the max, control brightness with PWM
-    for (uint8_t i = 0; i < AW_PWM_REGISTER_COUNT; i++) {
-        AW20216_write_register(cs_pin, AW_PAGE_SCALING, i, AW_SCALING_MAX);
-    }
+    // The register address auto-increments, so the whole page is written in one go
+    uint8_t scaling[AW_PWM_REGISTER_COUNT];
+    memset(scaling, AW_SCALING_MAX, sizeof(scaling));
+    AW20216_write(cs_pin, AW_PAGE_SCALING, 0, scaling, AW_PWM_REGISTER_COUNT);
 }
 
 static inline void AW20216_init_current_limit(pin_t cs_pin) {
@@ -121,10 +125,10 @@ void AW20216_init(pin_t cs_pin, pin_t en_pin) {
 void AW20216_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     aw_led led = g_aw_leds[index];
 
-    g_pwm_buffer[led.driver][led.r]          = red;
-    g_pwm_buffer[led.driver][led.g]          = green;
-    g_pwm_buffer[led.driver][led.b]          = blue;
-    g_pwm_buffer_update_required[led.driver] = true;
+    g_pwm_buffer[led.driver][AW_FRAME_HEADER_SIZE + led.r] = red;
+    g_pwm_buffer[led.driver][AW_FRAME_HEADER_SIZE + led.g] = green;
+    g_pwm_buffer[led.driver][AW_FRAME_HEADER_SIZE + led.b] = blue;
+    g_pwm_buffer_update_required[led.driver]               = true;
 }
 
 void AW20216_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
@@ -135,7 +139,9 @@ void AW20216_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 
 void AW20216_update_pwm_buffers(pin_t cs_pin, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
-        AW20216_write(cs_pin, AW_PAGE_PWM, 0, g_pwm_buffer[index], AW_PWM_REGISTER_COUNT);
+        // The buffer already has room for the header, so the frame is sent straight from it
+        AW20216_frame_header(g_pwm_buffer[index], AW_PAGE_PWM, 0);
+        AW20216_transmit(cs_pin, g_pwm_buffer[index], sizeof(g_pwm_buffer[index]));
     }
     g_pwm_buffer_update_required[index] = false;
 }
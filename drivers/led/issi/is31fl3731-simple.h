@@ -32,6 +32,7 @@ extern const is31_led __flash g_is31_leds[DRIVER_LED_TOTAL];
 void IS31FL3731_init(uint8_t addr);
 void IS31FL3731_write_register(uint8_t addr, uint8_t reg, uint8_t data);
 void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer);
+bool IS31FL3731_write_pwm_buffer_dirty(uint8_t addr, uint8_t *pwm_buffer, uint8_t *dirty);
 
 void IS31FL3731_set_value(int index, uint8_t value);
 void IS31FL3731_set_value_all(uint8_t value);
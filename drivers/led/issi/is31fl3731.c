@@ -16,8 +16,10 @@
  */
 
 #include "is31fl3731.h"
+#include "issi_dirty.h"
 #include "i2c_master.h"
 #include "wait.h"
+#include <string.h>
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -63,6 +65,7 @@ uint8_t g_twi_transfer_buffer[20];
 // probably not worth the extra complexity.
 uint8_t g_pwm_buffer[DRIVER_COUNT][144];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][144 / 8];
 
 uint8_t g_led_control_registers[DRIVER_COUNT][18]             = {{0}};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
@@ -121,6 +124,41 @@ void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     }
 }
 
+bool IS31FL3731_write_pwm_buffer_dirty(uint8_t addr, uint8_t *pwm_buffer, uint8_t *dirty) {
+    // assumes bank is already selected
+    uint16_t reg = 0;
+    uint8_t  length;
+    bool     success = true;
+    while ((length = issi_next_dirty_span(dirty, &reg, 144, 16)) > 0) {
+        g_twi_transfer_buffer[0] = 0x24 + reg;
+        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + reg, length);
+
+        bool sent = false;
+#if ISSI_PERSISTENCE > 0
+        for (uint8_t i = 0; i < ISSI_PERSISTENCE && !sent; i++) {
+            sent = i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) == 0;
+        }
+#else
+        sent = i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) == 0;
+#endif
+
+        // a span that didn't get through stays dirty for the next update
+        if (sent) {
+            issi_clear_span(dirty, reg, length);
+        } else {
+            success = false;
+        }
+        reg += length;
+    }
+    return success;
+}
+
+static inline void IS31FL3731_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (issi_set_register(g_pwm_buffer[driver], g_pwm_buffer_dirty[driver], reg, value)) {
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3731_init(uint8_t addr) {
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, first enable software shutdown,
@@ -178,10 +216,9 @@ void IS31FL3731_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         is31_led led = g_is31_leds[index];
 
         // Subtract 0x24 to get the second index of g_pwm_buffer
-        g_pwm_buffer[led.driver][led.r - 0x24]   = red;
-        g_pwm_buffer[led.driver][led.g - 0x24]   = green;
-        g_pwm_buffer[led.driver][led.b - 0x24]   = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3731_set_pwm_register(led.driver, led.r - 0x24, red);
+        IS31FL3731_set_pwm_register(led.driver, led.g - 0x24, green);
+        IS31FL3731_set_pwm_register(led.driver, led.b - 0x24, blue);
     }
 }
 
@@ -222,9 +259,9 @@ void IS31FL3731_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
-        IS31FL3731_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        // the registers that didn't get through are sent again on the next update
+        g_pwm_buffer_update_required[index] = !IS31FL3731_write_pwm_buffer_dirty(addr, g_pwm_buffer[index], g_pwm_buffer_dirty[index]);
     }
-    g_pwm_buffer_update_required[index] = false;
 }
 
 void IS31FL3731_update_led_control_registers(uint8_t addr, uint8_t index) {
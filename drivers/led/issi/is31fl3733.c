@@ -17,8 +17,10 @@
  */
 
 #include "is31fl3733.h"
+#include "issi_dirty.h"
 #include "i2c_master.h"
 #include "wait.h"
+#include <string.h>
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -67,6 +69,7 @@ uint8_t g_twi_transfer_buffer[20];
 // probably not worth the extra complexity.
 uint8_t g_pwm_buffer[DRIVER_COUNT][192];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][192 / 8];
 
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
@@ -121,6 +124,39 @@ bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     return true;
 }
 
+bool IS31FL3733_write_pwm_buffer_dirty(uint8_t addr, uint8_t *pwm_buffer, uint8_t *dirty) {
+    // Assumes PG1 is already selected.
+    uint16_t reg = 0;
+    uint8_t  length;
+    while ((length = issi_next_dirty_span(dirty, &reg, 192, 16)) > 0) {
+        g_twi_transfer_buffer[0] = reg;
+        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + reg, length);
+
+#if ISSI_PERSISTENCE > 0
+        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
+            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) != 0) {
+                return false;
+            }
+        }
+#else
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) != 0) {
+            return false;
+        }
+#endif
+
+        // only cleared once sent, a failed span is sent again on the next update
+        issi_clear_span(dirty, reg, length);
+        reg += length;
+    }
+    return true;
+}
+
+static inline void IS31FL3733_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (issi_set_register(g_pwm_buffer[driver], g_pwm_buffer_dirty[driver], reg, value)) {
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3733_init(uint8_t addr, uint8_t sync) {
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, shutdown is enabled last.
@@ -167,10 +203,9 @@ void IS31FL3733_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3733_set_pwm_register(led.driver, led.r, red);
+        IS31FL3733_set_pwm_register(led.driver, led.g, green);
+        IS31FL3733_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -216,12 +251,12 @@ void IS31FL3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
 
         // If any of the transactions fail we risk writing dirty PG0,
-        // refresh page 0 just in case.
-        if (!IS31FL3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+        // refresh page 0 just in case. The registers that didn't get through are sent again.
+        g_pwm_buffer_update_required[index] = !IS31FL3733_write_pwm_buffer_dirty(addr, g_pwm_buffer[index], g_pwm_buffer_dirty[index]);
+        if (g_pwm_buffer_update_required[index]) {
             g_led_control_registers_update_required[index] = true;
         }
     }
-    g_pwm_buffer_update_required[index] = false;
 }
 
 void IS31FL3733_update_led_control_registers(uint8_t addr, uint8_t index) {
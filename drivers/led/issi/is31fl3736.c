@@ -15,8 +15,10 @@
  */
 
 #include "is31fl3736.h"
+#include "issi_dirty.h"
 #include "i2c_master.h"
 #include "wait.h"
+#include <string.h>
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -65,6 +67,7 @@ uint8_t g_twi_transfer_buffer[20];
 // probably not worth the extra complexity.
 uint8_t g_pwm_buffer[DRIVER_COUNT][192];
 bool    g_pwm_buffer_update_required = false;
+uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][192 / 8];
 
 uint8_t g_led_control_registers[DRIVER_COUNT][24] = {{0}, {0}};
 bool    g_led_control_registers_update_required   = false;
@@ -108,6 +111,41 @@ void IS31FL3736_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     }
 }
 
+bool IS31FL3736_write_pwm_buffer_dirty(uint8_t addr, uint8_t *pwm_buffer, uint8_t *dirty) {
+    // assumes PG1 is already selected
+    uint16_t reg = 0;
+    uint8_t  length;
+    bool     success = true;
+    while ((length = issi_next_dirty_span(dirty, &reg, 192, 16)) > 0) {
+        g_twi_transfer_buffer[0] = reg;
+        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + reg, length);
+
+        bool sent = false;
+#if ISSI_PERSISTENCE > 0
+        for (uint8_t i = 0; i < ISSI_PERSISTENCE && !sent; i++) {
+            sent = i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) == 0;
+        }
+#else
+        sent = i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) == 0;
+#endif
+
+        // a span that didn't get through stays dirty for the next update
+        if (sent) {
+            issi_clear_span(dirty, reg, length);
+        } else {
+            success = false;
+        }
+        reg += length;
+    }
+    return success;
+}
+
+static inline void IS31FL3736_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (issi_set_register(g_pwm_buffer[driver], g_pwm_buffer_dirty[driver], reg, value)) {
+        g_pwm_buffer_update_required = true;
+    }
+}
+
 void IS31FL3736_init(uint8_t addr) {
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, shutdown is enabled last.
@@ -153,10 +191,9 @@ void IS31FL3736_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r] = red;
-        g_pwm_buffer[led.driver][led.g] = green;
-        g_pwm_buffer[led.driver][led.b] = blue;
-        g_pwm_buffer_update_required    = true;
+        IS31FL3736_set_pwm_register(led.driver, led.r, red);
+        IS31FL3736_set_pwm_register(led.driver, led.g, green);
+        IS31FL3736_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -213,9 +250,8 @@ void IS31FL3736_mono_set_brightness(int index, uint8_t value) {
     if (index >= 0 && index < 96) {
         // Index in range 0..95 -> A1..A8, B1..B8, etc.
         // Map index 0..95 to registers 0x00..0xBE (interleaved)
-        uint8_t pwm_register          = index * 2;
-        g_pwm_buffer[0][pwm_register] = value;
-        g_pwm_buffer_update_required  = true;
+        uint8_t pwm_register = index * 2;
+        IS31FL3736_set_pwm_register(0, pwm_register, value);
     }
 }
 
@@ -249,10 +285,10 @@ void IS31FL3736_update_pwm_buffers(uint8_t addr1, uint8_t addr2) {
         IS31FL3736_write_register(addr1, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
         IS31FL3736_write_register(addr1, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
 
-        IS31FL3736_write_pwm_buffer(addr1, g_pwm_buffer[0]);
+        // the registers that didn't get through are sent again on the next update
+        g_pwm_buffer_update_required = !IS31FL3736_write_pwm_buffer_dirty(addr1, g_pwm_buffer[0], g_pwm_buffer_dirty[0]);
         // IS31FL3736_write_pwm_buffer(addr2, g_pwm_buffer[1]);
     }
-    g_pwm_buffer_update_required = false;
 }
 
 void IS31FL3736_update_led_control_registers(uint8_t addr1, uint8_t addr2) {
@@ -17,8 +17,10 @@
  */
 
 #include "is31fl3737.h"
+#include "issi_dirty.h"
 #include "i2c_master.h"
 #include "wait.h"
+#include <string.h>
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -68,6 +70,7 @@ uint8_t g_twi_transfer_buffer[20];
 
 uint8_t g_pwm_buffer[DRIVER_COUNT][192];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][192 / 8];
 
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
@@ -111,6 +114,41 @@ void IS31FL3737_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     }
 }
 
+bool IS31FL3737_write_pwm_buffer_dirty(uint8_t addr, uint8_t *pwm_buffer, uint8_t *dirty) {
+    // assumes PG1 is already selected
+    uint16_t reg = 0;
+    uint8_t  length;
+    bool     success = true;
+    while ((length = issi_next_dirty_span(dirty, &reg, 192, 16)) > 0) {
+        g_twi_transfer_buffer[0] = reg;
+        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + reg, length);
+
+        bool sent = false;
+#if ISSI_PERSISTENCE > 0
+        for (uint8_t i = 0; i < ISSI_PERSISTENCE && !sent; i++) {
+            sent = i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) == 0;
+        }
+#else
+        sent = i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) == 0;
+#endif
+
+        // a span that didn't get through stays dirty for the next update
+        if (sent) {
+            issi_clear_span(dirty, reg, length);
+        } else {
+            success = false;
+        }
+        reg += length;
+    }
+    return success;
+}
+
+static inline void IS31FL3737_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (issi_set_register(g_pwm_buffer[driver], g_pwm_buffer_dirty[driver], reg, value)) {
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3737_init(uint8_t addr) {
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, shutdown is enabled last.
@@ -156,10 +194,9 @@ void IS31FL3737_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3737_set_pwm_register(led.driver, led.r, red);
+        IS31FL3737_set_pwm_register(led.driver, led.g, green);
+        IS31FL3737_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -204,9 +241,9 @@ void IS31FL3737_update_pwm_buffers(uint8_t addr, uint8_t index) {
         IS31FL3737_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
         IS31FL3737_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
 
-        IS31FL3737_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        // the registers that didn't get through are sent again on the next update
+        g_pwm_buffer_update_required[index] = !IS31FL3737_write_pwm_buffer_dirty(addr, g_pwm_buffer[index], g_pwm_buffer_dirty[index]);
     }
-    g_pwm_buffer_update_required[index] = false;
 }
 
 void IS31FL3737_update_led_control_registers(uint8_t addr, uint8_t index) {
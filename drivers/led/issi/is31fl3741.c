@@ -20,6 +20,7 @@
 #include "wait.h"
 
 #include "is31fl3741.h"
+#include "issi_dirty.h"
 #include <string.h>
 #include "i2c_master.h"
 #include "progmem.h"
@@ -74,6 +75,7 @@ uint8_t g_twi_transfer_buffer[20] = {0xFF};
 // probably not worth the extra complexity.
 uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT]        = {false};
+uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][(ISSI_MAX_LEDS + 7) / 8];
 bool    g_scaling_registers_update_required[DRIVER_COUNT] = {false};
 
 uint8_t g_scaling_registers[DRIVER_COUNT][ISSI_MAX_LEDS];
@@ -138,6 +140,50 @@ bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     return true;
 }
 
+bool IS31FL3741_write_pwm_buffer_dirty(uint8_t addr, uint8_t *pwm_buffer, uint8_t *dirty) {
+    // Registers 0-179 are on PG0 and 180-350 on PG1, a transfer never spans both
+    for (uint8_t page = 0; page < 2; page++) {
+        uint16_t reg      = page == 0 ? 0 : 180;
+        uint16_t end      = page == 0 ? 180 : ISSI_MAX_LEDS;
+        bool     selected = false;
+        uint8_t  length;
+        while ((length = issi_next_dirty_span(dirty, &reg, end, 18)) > 0) {
+            if (!selected) {
+                // unlock the command register and select the page
+                IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
+                IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, page == 0 ? ISSI_PAGE_PWM0 : ISSI_PAGE_PWM1);
+                selected = true;
+            }
+
+            g_twi_transfer_buffer[0] = reg % 180;
+            memcpy(g_twi_transfer_buffer + 1, pwm_buffer + reg, length);
+
+#if ISSI_PERSISTENCE > 0
+            for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
+                if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) != 0) {
+                    return false;
+                }
+            }
+#else
+            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) != 0) {
+                return false;
+            }
+#endif
+
+            // only cleared once sent, a failed span is sent again on the next update
+            issi_clear_span(dirty, reg, length);
+            reg += length;
+        }
+    }
+    return true;
+}
+
+static inline void IS31FL3741_set_pwm_register(uint8_t driver, uint16_t reg, uint8_t value) {
+    if (issi_set_register(g_pwm_buffer[driver], g_pwm_buffer_dirty[driver], reg, value)) {
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3741_init(uint8_t addr) {
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, shutdown is enabled last.
@@ -169,10 +215,9 @@ void IS31FL3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3741_set_pwm_register(led.driver, led.r, red);
+        IS31FL3741_set_pwm_register(led.driver, led.g, green);
+        IS31FL3741_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -208,18 +253,15 @@ void IS31FL3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void IS31FL3741_update_pwm_buffers(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
-        IS31FL3741_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        // the registers that didn't get through are sent again on the next update
+        g_pwm_buffer_update_required[index] = !IS31FL3741_write_pwm_buffer_dirty(addr, g_pwm_buffer[index], g_pwm_buffer_dirty[index]);
     }
-
-    g_pwm_buffer_update_required[index] = false;
 }
 
 void IS31FL3741_set_pwm_buffer(const is31_led *pled, uint8_t red, uint8_t green, uint8_t blue) {
-    g_pwm_buffer[pled->driver][pled->r] = red;
-    g_pwm_buffer[pled->driver][pled->g] = green;
-    g_pwm_buffer[pled->driver][pled->b] = blue;
-
-    g_pwm_buffer_update_required[pled->driver] = true;
+    IS31FL3741_set_pwm_register(pled->driver, pled->r, red);
+    IS31FL3741_set_pwm_register(pled->driver, pled->g, green);
+    IS31FL3741_set_pwm_register(pled->driver, pled->b, blue);
 }
 
 void IS31FL3741_update_led_control_registers(uint8_t addr, uint8_t index) {
@@ -0,0 +1,75 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Dirty register tracking shared by the ISSI drivers.
+ *
+ * A driver keeps one bit per PWM register, set when the register changes value, and
+ * only sends the marked registers on update. Changed registers at most
+ * ISSI_DIRTY_MERGE_GAP apart go out in one transfer, as the I2C overhead of a new
+ * transfer costs more than resending a few unchanged bytes.
+ */
+
+#ifndef ISSI_DIRTY_MERGE_GAP
+#    define ISSI_DIRTY_MERGE_GAP 2
+#endif
+
+static inline bool issi_is_dirty(const uint8_t *dirty, uint16_t reg) { return dirty[reg / 8] & (1 << (reg % 8)); }
+
+// Stores value in register reg of buffer, and marks it dirty if that changed it. Returns whether it did.
+static inline bool issi_set_register(uint8_t *buffer, uint8_t *dirty, uint16_t reg, uint8_t value) {
+    if (buffer[reg] == value) {
+        return false;
+    }
+    buffer[reg] = value;
+    dirty[reg / 8] |= (1 << (reg % 8));
+    return true;
+}
+
+// Clears the dirty marks of a span, once it has been sent
+static inline void issi_clear_span(uint8_t *dirty, uint16_t reg, uint8_t length) {
+    for (uint16_t i = reg; i < reg + length; i++) {
+        dirty[i / 8] &= ~(1 << (i % 8));
+    }
+}
+
+/* Finds the next span of registers to send, searching from *reg up to, but not including, end.
+ * Moves *reg to the first register of the span and returns its length, which is at most
+ * max_length, or returns 0 when no dirty register is left.
+ */
+static inline uint8_t issi_next_dirty_span(const uint8_t *dirty, uint16_t *reg, uint16_t end, uint8_t max_length) {
+    uint16_t start = *reg;
+    while (start < end && !issi_is_dirty(dirty, start)) {
+        // skip a whole byte of clean registers at once
+        start = (start % 8 == 0 && dirty[start / 8] == 0) ? start + 8 : start + 1;
+    }
+    if (start >= end) {
+        return 0;
+    }
+
+    uint16_t last = start;
+    for (uint16_t i = start + 1; i < end && i - start < max_length && i - last <= ISSI_DIRTY_MERGE_GAP + 1; i++) {
+        if (issi_is_dirty(dirty, i)) {
+            last = i;
+        }
+    }
+    *reg = start;
+    return last - start + 1;
+}
@@ -0,0 +1,155 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "drivers/led/issi/issi_dirty.h"
+}
+
+// Register counts of the IS31FL3733 and one IS31FL3741 page
+#define REGISTER_COUNT 192
+#define PAGE_SIZE 180
+
+class IssiDirty : public ::testing::Test {
+   protected:
+    uint8_t buffer[REGISTER_COUNT];
+    uint8_t dirty[REGISTER_COUNT / 8];
+
+    void SetUp() override {
+        memset(buffer, 0, sizeof(buffer));
+        memset(dirty, 0, sizeof(dirty));
+    }
+
+    void set(std::vector<uint16_t> regs) {
+        for (uint16_t reg : regs) {
+            issi_set_register(buffer, dirty, reg, 0xFF);
+        }
+    }
+
+    // Returns the (start, length) of every span in [begin, end)
+    std::vector<std::pair<uint16_t, uint8_t>> spans(uint16_t begin, uint16_t end, uint8_t max_length) {
+        std::vector<std::pair<uint16_t, uint8_t>> result;
+        uint16_t                                  reg = begin;
+        uint8_t                                   length;
+        while ((length = issi_next_dirty_span(dirty, &reg, end, max_length)) > 0) {
+            result.push_back({reg, length});
+            reg += length;
+        }
+        return result;
+    }
+};
+
+using Spans = std::vector<std::pair<uint16_t, uint8_t>>;
+
+TEST_F(IssiDirty, SetRegisterMarksOnlyChanges) {
+    EXPECT_TRUE(issi_set_register(buffer, dirty, 10, 0x40));
+    EXPECT_EQ(buffer[10], 0x40);
+    EXPECT_TRUE(issi_is_dirty(dirty, 10));
+    EXPECT_FALSE(issi_is_dirty(dirty, 9));
+    EXPECT_FALSE(issi_is_dirty(dirty, 11));
+
+    memset(dirty, 0, sizeof(dirty));
+    EXPECT_FALSE(issi_set_register(buffer, dirty, 10, 0x40));
+    EXPECT_FALSE(issi_is_dirty(dirty, 10));
+}
+
+TEST_F(IssiDirty, CleanBufferHasNoSpans) {
+    uint16_t reg = 0;
+    EXPECT_EQ(issi_next_dirty_span(dirty, &reg, REGISTER_COUNT, 16), 0);
+    EXPECT_TRUE(spans(0, REGISTER_COUNT, 16).empty());
+}
+
+TEST_F(IssiDirty, SingleRegister) {
+    set({0});
+    EXPECT_EQ(spans(0, REGISTER_COUNT, 16), (Spans{{0, 1}}));
+    SetUp();
+    set({REGISTER_COUNT - 1});
+    EXPECT_EQ(spans(0, REGISTER_COUNT, 16), (Spans{{REGISTER_COUNT - 1, 1}}));
+}
+
+TEST_F(IssiDirty, MergesWithinGap) {
+    // ISSI_DIRTY_MERGE_GAP clean registers between 20 and 23
+    set({20, 20 + ISSI_DIRTY_MERGE_GAP + 1});
+    EXPECT_EQ(spans(0, REGISTER_COUNT, 16), (Spans{{20, ISSI_DIRTY_MERGE_GAP + 2}}));
+}
+
+TEST_F(IssiDirty, SplitsPastGap) {
+    set({20, 20 + ISSI_DIRTY_MERGE_GAP + 2});
+    EXPECT_EQ(spans(0, REGISTER_COUNT, 16), (Spans{{20, 1}, {20 + ISSI_DIRTY_MERGE_GAP + 2, 1}}));
+}
+
+TEST_F(IssiDirty, SpanDoesNotEndOnCleanRegisters) {
+    set({40, 41, 42});
+    EXPECT_EQ(spans(0, REGISTER_COUNT, 16), (Spans{{40, 3}}));
+}
+
+TEST_F(IssiDirty, CapsSpanLength) {
+    for (uint16_t reg = 0; reg < 40; reg++) {
+        set({reg});
+    }
+    EXPECT_EQ(spans(0, REGISTER_COUNT, 16), (Spans{{0, 16}, {16, 16}, {32, 8}}));
+    EXPECT_EQ(spans(0, REGISTER_COUNT, 18), (Spans{{0, 18}, {18, 18}, {36, 4}}));
+}
+
+TEST_F(IssiDirty, StopsAtEnd) {
+    // A span must not cross from one IS31FL3741 page into the next
+    set({PAGE_SIZE - 2, PAGE_SIZE - 1, PAGE_SIZE, PAGE_SIZE + 1});
+    EXPECT_EQ(spans(0, PAGE_SIZE, 18), (Spans{{PAGE_SIZE - 2, 2}}));
+    EXPECT_EQ(spans(PAGE_SIZE, REGISTER_COUNT, 18), (Spans{{PAGE_SIZE, 2}}));
+}
+
+TEST_F(IssiDirty, ClearSpanKeepsOtherRegistersDirty) {
+    // As after a span failed to send while the ones around it got through
+    set({5, 6, 7, 8, 9, 30, 31});
+    issi_clear_span(dirty, 5, 3);
+    issi_clear_span(dirty, 30, 2);
+    EXPECT_EQ(spans(0, REGISTER_COUNT, 16), (Spans{{8, 2}}));
+}
+
+TEST_F(IssiDirty, FindsEveryDirtyRegister) {
+    // Every dirty register must be sent exactly once and no register twice, whatever the pattern
+    srand(1);
+    for (int pass = 0; pass < 200; pass++) {
+        SetUp();
+        std::vector<bool> expected(REGISTER_COUNT);
+        for (uint16_t reg = 0; reg < REGISTER_COUNT; reg++) {
+            if (rand() % 5 == 0) {
+                set({reg});
+                expected[reg] = true;
+            }
+        }
+        std::vector<int> sent(REGISTER_COUNT);
+        for (auto span : spans(0, REGISTER_COUNT, 16)) {
+            EXPECT_LE(span.second, 16);
+            EXPECT_TRUE(expected[span.first]);
+            EXPECT_TRUE(expected[span.first + span.second - 1]);
+            for (uint16_t reg = span.first; reg < span.first + span.second; reg++) {
+                sent[reg]++;
+            }
+        }
+        for (uint16_t reg = 0; reg < REGISTER_COUNT; reg++) {
+            EXPECT_LE(sent[reg], 1) << "register " << reg;
+            if (expected[reg]) {
+                EXPECT_EQ(sent[reg], 1) << "register " << reg;
+            }
+        }
+    }
+}
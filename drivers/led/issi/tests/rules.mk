@@ -0,0 +1,6 @@
+# Same letter case as the other unit tests, see quantum/sequencer/tests/rules.mk
+
+issi_dirty_DEFS := -DNO_DEBUG
+
+issi_dirty_SRC := \
+	$(DRIVER_PATH)/led/issi/tests/issi_dirty_tests.cpp
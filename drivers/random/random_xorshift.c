@@ -0,0 +1,51 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "random.h"
+#include "timer.h"
+
+#ifdef RANDOM_DRIVER_ADC
+#    include "gpio.h"
+#    include "analog.h"
+
+#    ifndef RANDOM_ADC_PIN
+#        error "RANDOM_DRIVER = adc needs an analog pin to sample, please define RANDOM_ADC_PIN"
+#    endif
+// ADC readings mixed into the seed
+#    ifndef RANDOM_ADC_SAMPLES
+#        define RANDOM_ADC_SAMPLES 32
+#    endif
+#endif
+
+static uint32_t xorshift_state;
+
+void random_driver_init(void) {
+    uint32_t seed = timer_read32();
+#ifdef RANDOM_DRIVER_ADC
+    // Only the lowest bits of an unconnected or noisy pin are worth anything, rotate them across the whole seed
+    for (uint8_t i = 0; i < RANDOM_ADC_SAMPLES; i++) {
+        seed = ((seed << 5) | (seed >> 27)) ^ (uint16_t)analogReadPin(RANDOM_ADC_PIN);
+    }
+#endif
+    xorshift_state = seed;
+}
+
+void random_driver_fill(void *data, size_t size) { random_xorshift_fill(&xorshift_state, data, size); }
+
+void random_driver_add_entropy(uint32_t value) {
+    // The timer seed is much the same on every boot, key press times are not
+    xorshift_state = ((xorshift_state << 7) | (xorshift_state >> 25)) ^ value;
+}
@@ -177,19 +177,22 @@ Lib8tion is pronounced like 'libation': lie-BAY-shun
 
 #if defined(__arm__)
 
-#if defined(FASTLED_TEENSY3)
-// Can use Cortex M4 DSP instructions
+#if defined(FASTLED_TEENSY3) || defined(__ARM_FEATURE_DSP)
+// Can use Cortex M4/M7 DSP instructions
 #define QADD8_C 0
 #define QADD7_C 0
+#define QSUB8_C 0
 #define QADD8_ARM_DSP_ASM 1
 #define QADD7_ARM_DSP_ASM 1
+#define QSUB8_ARM_DSP_ASM 1
+#define LIB8_ARM_DSP 1
 #else
 // Generic ARM
 #define QADD8_C 1
 #define QADD7_C 1
+#define QSUB8_C 1
 #endif
 
-#define QSUB8_C 1
 #define SCALE8_C 1
 #define SCALE16BY8_C 1
 #define SCALE16_C 1
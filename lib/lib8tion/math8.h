@@ -108,11 +108,64 @@ LIB8STATIC_ALWAYS_INLINE uint8_t qsub8( uint8_t i, uint8_t j)
          : "a"  (j) );
 
     return i;
+#elif QSUB8_ARM_DSP_ASM == 1
+    asm volatile( "uqsub8 %0, %0, %1" : "+r" (i) : "r" (j));
+    return i;
 #else
 #error "No implementation for qsub8 available."
 #endif
 }
 
+///@defgroup Packed Four lane versions
+/// These work on four bytes packed into a uint32_t at once, lane
+/// by lane, with the same result as the single byte functions.
+/// On Cortex-M4/M7 each is a single SIMD instruction, elsewhere
+/// they use plain 32-bit arithmetic, which still beats four calls.
+///@{
+
+/// add four bytes to four others, each saturating at 0xFF
+LIB8STATIC_ALWAYS_INLINE uint32_t qadd8x4( uint32_t i, uint32_t j)
+{
+#if LIB8_ARM_DSP == 1
+    asm( "uqadd8 %0, %0, %1" : "+r" (i) : "r" (j));
+    return i;
+#else
+    // add the low seven bits of every lane, then put the top bits back in
+    uint32_t sum = ((i & 0x7F7F7F7F) + (j & 0x7F7F7F7F)) ^ ((i ^ j) & 0x80808080);
+    // lanes that carried out of their top bit become 0xFF
+    uint32_t carry = ((i & j) | ((i | j) & ~sum)) & 0x80808080;
+    return sum | ((carry >> 7) * 0xFF);
+#endif
+}
+
+/// subtract four bytes from four others, each with a floor of 0x00
+LIB8STATIC_ALWAYS_INLINE uint32_t qsub8x4( uint32_t i, uint32_t j)
+{
+#if LIB8_ARM_DSP == 1
+    asm( "uqsub8 %0, %0, %1" : "+r" (i) : "r" (j));
+    return i;
+#else
+    // subtract with the top bit of every lane set, so no lane borrows from the next
+    uint32_t diff = ((i | 0x80808080) - (j & 0x7F7F7F7F)) ^ ((i ^ ~j) & 0x80808080);
+    // lanes that borrowed past their top bit become 0x00
+    uint32_t borrow = ((~i & j) | (~(i ^ j) & diff)) & 0x80808080;
+    return diff & ~((borrow >> 7) * 0xFF);
+#endif
+}
+
+/// average of four bytes and four others, lane by lane, rounded down
+LIB8STATIC_ALWAYS_INLINE uint32_t avg8x4( uint32_t i, uint32_t j)
+{
+#if LIB8_ARM_DSP == 1
+    asm( "uhadd8 %0, %0, %1" : "+r" (i) : "r" (j));
+    return i;
+#else
+    return (i & j) + (((i ^ j) >> 1) & 0x7F7F7F7F);
+#endif
+}
+
+///@}
+
 /// add one byte to another, with one byte result
 LIB8STATIC_ALWAYS_INLINE uint8_t add8( uint8_t i, uint8_t j)
 {
@@ -472,6 +472,28 @@ LIB8STATIC uint16_t scale16( uint16_t i, fract16 scale )
     #error "No implementation for scale16 available."
 #endif
 }
+
+/// scale four bytes packed into a uint32_t by the same fraction,
+/// with the same result as scale8 on each of them. Each pair of
+/// alternate lanes takes one 32-bit multiply, as every product
+/// fits in its 16-bit half.
+LIB8STATIC_ALWAYS_INLINE uint32_t scale8x4( uint32_t i, fract8 scale)
+{
+#if (FASTLED_SCALE8_FIXED == 1)
+    uint32_t factor = (uint32_t)scale + 1;
+#else
+    uint32_t factor = scale;
+#endif
+    uint32_t even, odd;
+#if LIB8_ARM_DSP == 1
+    asm( "uxtb16 %0, %1" : "=r" (even) : "r" (i));
+    asm( "uxtb16 %0, %1, ror #8" : "=r" (odd) : "r" (i));
+#else
+    even = i & 0x00FF00FF;
+    odd  = (i >> 8) & 0x00FF00FF;
+#endif
+    return (((even * factor) >> 8) & 0x00FF00FF) | ((odd * factor) & 0xFF00FF00);
+}
 ///@}
 
 ///@defgroup Dimming Dimming and brightening functions
@@ -0,0 +1,115 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "lib/lib8tion/lib8tion.h"
+}
+
+// Bytes run through each function per benchmark pass, and how many passes are timed
+#define LIB8TION_BENCH_BYTES 4096
+#define LIB8TION_BENCH_PASSES 2000
+
+static uint32_t pack(uint8_t a, uint8_t b, uint8_t c, uint8_t d) { return a | (b << 8) | (c << 16) | ((uint32_t)d << 24); }
+
+static uint8_t lane(uint32_t x, uint8_t n) { return x >> (n * 8); }
+
+// Puts a and b in the given lane, with bytes around them that push towards a carry or borrow into it
+template <typename Packed, typename Single>
+static void expect_lanes_match(Packed packed, Single single, const char* name) {
+    for (uint16_t a = 0; a < 256; a++) {
+        for (uint16_t b = 0; b < 256; b++) {
+            for (uint8_t n = 0; n < 4; n++) {
+                uint8_t  fill_i = n % 2 ? 0xFF : 0x00;
+                uint8_t  fill_j = n % 2 ? 0xFF : 0x01;
+                uint32_t i      = pack(fill_i, fill_i, fill_i, fill_i) & ~(0xFFu << (n * 8));
+                uint32_t j      = pack(fill_j, fill_j, fill_j, fill_j) & ~(0xFFu << (n * 8));
+                i |= (uint32_t)a << (n * 8);
+                j |= (uint32_t)b << (n * 8);
+                uint32_t result = packed(i, j);
+                for (uint8_t m = 0; m < 4; m++) {
+                    ASSERT_EQ(lane(result, m), single(lane(i, m), lane(j, m))) << name << "(" << a << ", " << b << ") in lane " << (int)n << ", lane " << (int)m << " wrong";
+                }
+            }
+        }
+    }
+}
+
+TEST(Lib8tion, Qadd8x4MatchesQadd8) { expect_lanes_match(qadd8x4, qadd8, "qadd8x4"); }
+
+TEST(Lib8tion, Qsub8x4MatchesQsub8) { expect_lanes_match(qsub8x4, qsub8, "qsub8x4"); }
+
+TEST(Lib8tion, Avg8x4MatchesAvg8) { expect_lanes_match(avg8x4, avg8, "avg8x4"); }
+
+// All four lanes share one scale, so only the bytes vary from lane to lane
+TEST(Lib8tion, Scale8x4MatchesScale8) {
+    for (uint16_t a = 0; a < 256; a++) {
+        for (uint16_t scale = 0; scale < 256; scale++) {
+            for (uint8_t n = 0; n < 4; n++) {
+                uint32_t i      = (pack(0xFF, 0x80, 0x7F, 0x01) & ~(0xFFu << (n * 8))) | (uint32_t)a << (n * 8);
+                uint32_t result = scale8x4(i, scale);
+                for (uint8_t m = 0; m < 4; m++) {
+                    ASSERT_EQ(lane(result, m), scale8(lane(i, m), scale)) << "scale8x4(" << a << ", " << scale << ") in lane " << (int)n << ", lane " << (int)m << " wrong";
+                }
+            }
+        }
+    }
+}
+
+// Times a pass over the bytes done one byte at a time against the same pass done four at a time
+template <typename Single, typename Packed>
+static void bench(const char* name, Single single, Packed packed) {
+    std::vector<uint8_t>  bytes(LIB8TION_BENCH_BYTES);
+    std::vector<uint32_t> words(LIB8TION_BENCH_BYTES / 4);
+    for (uint16_t k = 0; k < LIB8TION_BENCH_BYTES; k++) bytes[k] = k * 37;
+    for (uint16_t k = 0; k < LIB8TION_BENCH_BYTES / 4; k++) words[k] = pack(bytes[k * 4], bytes[k * 4 + 1], bytes[k * 4 + 2], bytes[k * 4 + 3]);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint16_t pass = 0; pass < LIB8TION_BENCH_PASSES; pass++) {
+        for (uint8_t& byte : bytes) byte = single(byte, pass);
+    }
+    double single_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (uint16_t pass = 0; pass < LIB8TION_BENCH_PASSES; pass++) {
+        uint8_t  operand = pass;
+        uint32_t spread  = pack(operand, operand, operand, operand);
+        for (uint32_t& word : words) word = packed(word, spread, operand);
+    }
+    double packed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    // Both ran the same passes over the same data, so they have to end up the same
+    for (uint16_t k = 0; k < LIB8TION_BENCH_BYTES; k++) {
+        ASSERT_EQ(bytes[k], lane(words[k / 4], k % 4)) << name << " byte " << k;
+    }
+
+    double total = (double)LIB8TION_BENCH_BYTES * LIB8TION_BENCH_PASSES;
+    printf("%-10s %10.3f %10.3f %8.2fx\n", name, single_ns / total, packed_ns / total, single_ns / packed_ns);
+}
+
+// Not a pass/fail check on speed, the numbers only mean something on the same machine and compiler
+TEST(Lib8tion, Benchmark) {
+    printf("%-10s %10s %10s %9s\n", "function", "ns/byte", "x4 ns/byte", "speedup");
+    bench("qadd8", [](uint8_t i, uint8_t j) { return qadd8(i, j); }, [](uint32_t i, uint32_t j, uint8_t) { return qadd8x4(i, j); });
+    bench("qsub8", [](uint8_t i, uint8_t j) { return qsub8(i, j); }, [](uint32_t i, uint32_t j, uint8_t) { return qsub8x4(i, j); });
+    bench("avg8", [](uint8_t i, uint8_t j) { return avg8(i, j); }, [](uint32_t i, uint32_t j, uint8_t) { return avg8x4(i, j); });
+    bench("scale8", [](uint8_t i, uint8_t j) { return scale8(i, j); }, [](uint32_t i, uint32_t, uint8_t scale) { return scale8x4(i, scale); });
+}
@@ -0,0 +1,6 @@
+# Same letter case as the other unit tests, see quantum/sequencer/tests/rules.mk
+
+lib8tion_DEFS := -DNO_DEBUG
+
+lib8tion_SRC := \
+	$(LIB_PATH)/lib8tion/tests/lib8tion_tests.cpp
@@ -0,0 +1,272 @@
+"""Encode an animation into a keyframe header for RGB Matrix and LED Matrix.
+"""
+import json
+import re
+from argparse import ArgumentTypeError
+
+from milc import cli
+
+import qmk.path
+
+# Longest run a single op of the stream can cover
+MAX_SKIP = 0x7F
+MAX_RUN = 0x40
+
+# Shortest stretch of one index that is cheaper as a fill than as literals
+MIN_FILL = 3
+
+
+def frame_ms(value):
+    value = int(value)
+    if value in range(1, 65536):
+        return value
+    else:
+        raise ArgumentTypeError('Frame time must be between 1 and 65535 ms')
+
+
+def parse_color(value):
+    """Turns one LED of a JSON frame into a (red, green, blue) tuple.
+
+    An LED can be a "#RRGGBB" string, a [red, green, blue] list or a single brightness.
+    """
+    if isinstance(value, str):
+        match = re.fullmatch(r'#?([0-9a-fA-F]{6})', value)
+        if not match:
+            raise ValueError(f'Invalid color "{value}"')
+        value = int(match.group(1), 16)
+        return (value >> 16, (value >> 8) & 0xFF, value & 0xFF)
+
+    if isinstance(value, int):
+        value = [value] * 3
+
+    if not isinstance(value, list) or len(value) != 3 or any(not isinstance(channel, int) or channel not in range(256) for channel in value):
+        raise ValueError(f'Invalid color {value}')
+
+    return tuple(value)
+
+
+def read_json(path):
+    """Reads {"frame_ms": 50, "frames": [[led, led, ...], ...]}, or just the list of frames.
+    """
+    animation = json.loads(path.read_text())
+    if isinstance(animation, list):
+        animation = {'frames': animation}
+
+    return animation.get('frame_ms'), [[parse_color(led) for led in frame] for frame in animation['frames']]
+
+
+def read_ppm(path):
+    """Reads a binary or plain PPM image, which needs nothing beyond the standard library.
+    """
+    data = path.read_bytes()
+    tokens = []
+    pos = 0
+    # The header is four tokens, comments run to the end of the line
+    while len(tokens) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            pos = data.index(b'\n', pos)
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(data[start:pos])
+
+    magic, width, height, maxval = tokens[0], int(tokens[1]), int(tokens[2]), int(tokens[3])
+    if magic == b'P6' and maxval < 256:
+        pixels = data[pos + 1:pos + 1 + width * height * 3]
+    elif magic == b'P3':
+        pixels = [int(value) for value in data[pos:].split()]
+    else:
+        raise ValueError(f'{path} is not an 8 bit PPM image')
+
+    pixels = [round(value * 255 / maxval) for value in pixels[:width * height * 3]]
+    return [[tuple(pixels[(y * width + x) * 3:(y * width + x) * 3 + 3]) for x in range(width)] for y in range(height)]
+
+
+def read_image(path):
+    """Reads an image strip, every row of pixels is a frame and every column an LED.
+
+    The frames of an animated GIF follow one another.
+    """
+    if path.suffix.lower() in ('.ppm', '.pnm'):
+        return None, read_ppm(path)
+
+    try:
+        from PIL import Image, ImageSequence
+    except ImportError:
+        raise ValueError(f'Reading {path.suffix} files needs Pillow, run `python3 -m pip install pillow` or convert the strip to PPM or JSON')
+
+    frames = []
+    duration = None
+    with Image.open(path) as image:
+        for picture in ImageSequence.Iterator(image):
+            duration = duration or picture.info.get('duration')
+            picture = picture.convert('RGB')
+            width, height = picture.size
+            pixels = list(picture.getdata())
+            frames.extend(pixels[y * width:(y + 1) * width] for y in range(height))
+
+    return duration, frames
+
+
+def quantize(frames):
+    """Drops the low bits of every channel until the animation fits a palette of 256 colors.
+    """
+    for bits in range(8, 0, -1):
+        shift = 8 - bits
+        # the middle of each step, so a full channel still comes out close to 255
+        level = (lambda channel: channel) if shift == 0 else (lambda channel: (channel >> shift << shift) | (1 << (shift - 1)))
+        quantized = [[tuple(level(channel) for channel in led) for led in frame] for frame in frames]
+        if len({led for frame in quantized for led in frame}) <= 256:
+            return bits, quantized
+
+
+def encode_frame(previous, current):
+    """Encodes the runs that turn the previous frame into the current one, or all of it when there is none.
+    """
+    ops = []
+    count = len(current)
+    i = 0
+    while i < count:
+        if previous is not None and previous[i] == current[i]:
+            run = 1
+            while i + run < count and run < MAX_SKIP and previous[i + run] == current[i + run]:
+                run += 1
+            if i + run == count:
+                # The end of the frame leaves the rest as it is
+                break
+            ops.append(run)
+            i += run
+            continue
+
+        run = 1
+        while i + run < count and run < MAX_RUN and current[i + run] == current[i]:
+            run += 1
+        if run >= MIN_FILL:
+            ops.extend([0xC0 | (run - 1), current[i]])
+            i += run
+            continue
+
+        # Literals go on until two LEDs in a row, or the last one, stay the same or a fill would be cheaper
+        start = i
+        while i < count and i - start < MAX_RUN:
+            if previous is not None and previous[i] == current[i] and (i + 1 == count or previous[i + 1] == current[i + 1]):
+                break
+            if i > start and i + MIN_FILL <= count and current[i:i + MIN_FILL] == [current[i]] * MIN_FILL:
+                break
+            i += 1
+        ops.append(0x80 | (i - start - 1))
+        ops.extend(current[start:i])
+
+    ops.append(0x00)
+    return ops
+
+
+def format_bytes(values, per_line=16):
+    lines = []
+    for start in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(f'0x{value:02X}' for value in values[start:start + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+@cli.argument('filename', arg_only=True, type=qmk.path.normpath, help='The animation, as JSON or as an image strip with one row of pixels per frame')
+@cli.argument('-n', '--name', arg_only=True, help='Name of the animation in C. Default: the name of the file followed by _keyframes')
+@cli.argument('-f', '--frame-ms', arg_only=True, type=frame_ms, help='How long each frame is shown, in ms. Default: from the file, otherwise 33')
+@cli.argument('-l', '--led-matrix', arg_only=True, action='store_true', help='Encode brightness for LED Matrix instead of colors for RGB Matrix')
+@cli.argument('-o', '--output', arg_only=True, type=qmk.path.normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help='Quiet mode, only output error messages')
+@cli.subcommand('Encodes an animation into a keyframe header for RGB Matrix or LED Matrix.')
+def generate_keyframes(cli):
+    """Generates a header holding an animation as a palette and a stream of frame deltas, for effect_runner_keyframes().
+    """
+    path = cli.args.filename
+    if not path.exists():
+        cli.log.error('No such file: %s', path)
+        return False
+
+    try:
+        if path.suffix.lower() == '.json':
+            file_ms, frames = read_json(path)
+        else:
+            file_ms, frames = read_image(path)
+    except (ValueError, KeyError, IndexError) as e:
+        cli.log.error('Could not read %s: %s', path, e)
+        return False
+
+    if not frames or not frames[0]:
+        cli.log.error('%s has no frames', path)
+        return False
+    if len(frames) > 65535:
+        cli.log.error('An animation can have at most 65535 frames, %s has %d', path, len(frames))
+        return False
+
+    led_count = len(frames[0])
+    if led_count > 255 or any(len(frame) != led_count for frame in frames):
+        cli.log.error('Every frame needs the same number of LEDs, at most 255')
+        return False
+
+    if cli.args.led_matrix:
+        # A single color LED shows the brightest channel
+        frames = [[(max(led), ) for led in frame] for frame in frames]
+
+    bits, frames = quantize(frames)
+    palette = []
+    indices = {}
+    for frame in frames:
+        for led in frame:
+            if led not in indices:
+                indices[led] = len(palette)
+                palette.append(led)
+
+    stream = []
+    previous = None
+    for frame in frames:
+        current = [indices[led] for led in frame]
+        stream.extend(encode_frame(previous, current))
+        previous = current
+
+    name = cli.args.name or re.sub(r'\W', '_', path.stem) + '_keyframes'
+    if not re.fullmatch(r'[A-Za-z_]\w*', name):
+        name = '_' + name
+    ms = cli.args.frame_ms or file_ms or 33
+    kind = 'led_matrix' if cli.args.led_matrix else 'rgb_matrix'
+    raw = len(frames) * led_count * len(palette[0])
+    notes = '' if bits == 8 else f'\n// Colors were reduced to {bits} bits per channel to fit a palette of 256'
+
+    header = f'''#pragma once
+
+// clang-format off
+
+// Generated by `qmk generate-keyframes` from {path.name}
+// {led_count} LEDs, {len(frames)} frames of {ms}ms, {len(palette)} colors
+// {len(stream)} bytes of frames, {raw} uncompressed{notes}
+
+static const uint8_t PROGMEM {name}_palette[] = {{
+{format_bytes([channel for color in palette for channel in color], 12 if len(palette[0]) == 3 else 16)}
+}};
+
+static const uint8_t PROGMEM {name}_stream[] = {{
+{format_bytes(stream)}
+}};
+
+static const {kind}_keyframes_t {name} = {{
+    .palette   = {name}_palette,
+    .stream    = {name}_stream,
+    .frames    = {len(frames)},
+    .frame_ms  = {ms},
+    .led_count = {led_count},
+}};
+'''
+
+    if cli.args.output:
+        cli.args.output.parent.mkdir(parents=True, exist_ok=True)
+        if cli.args.output.exists():
+            cli.args.output.replace(cli.args.output.parent / (cli.args.output.name + '.bak'))
+        cli.args.output.write_text(header)
+
+        if not cli.args.quiet:
+            cli.log.info('Wrote %d frames, %d bytes, to %s.', len(frames), len(palette) * len(palette[0]) + len(stream), cli.args.output)
+    else:
+        print(header)
@@ -235,6 +235,13 @@ def test_generate_rgb_breathe_table():
     assert 'Breathing max:    127' in result.stdout
 
 
+def test_generate_keyframes():
+    result = check_subcommand('generate-keyframes', 'tests/rgb_matrix/marching_dots.json')
+    check_returncode(result)
+    assert '16 LEDs, 8 frames of 50ms, 2 colors' in result.stdout
+    assert 'static const rgb_matrix_keyframes_t marching_dots_keyframes' in result.stdout
+
+
 def test_generate_config_h():
     result = check_subcommand('generate-config-h', '-kb', 'handwired/pytest/basic')
     check_returncode(result)
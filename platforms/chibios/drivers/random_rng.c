@@ -0,0 +1,73 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <hal.h>
+#include "random.h"
+
+#if !defined(RNG)
+#    error "RANDOM_DRIVER = rng needs an MCU with an RNG peripheral, use RANDOM_DRIVER = adc or xorshift instead"
+#endif
+
+void random_driver_init(void) {
+#if defined(RCC_AHB2ENR_RNGEN)
+    rccEnableAHB2(RCC_AHB2ENR_RNGEN, true);
+#elif defined(RCC_AHBENR_RNGEN)
+    rccEnableAHB(RCC_AHBENR_RNGEN, true);
+#endif
+    RNG->CR |= RNG_CR_RNGEN;
+}
+
+// Status polls before rng_read() gives up on the peripheral
+#ifndef RANDOM_RNG_MAX_POLLS
+#    define RANDOM_RNG_MAX_POLLS 10000
+#endif
+
+static uint32_t last_value;
+
+static uint32_t rng_read(void) {
+    for (uint16_t i = 0; i < RANDOM_RNG_MAX_POLLS; i++) {
+        uint32_t status = RNG->SR;
+        if (status & RNG_SR_SEIS) {
+            // A seed error discards the pending value, restarting the peripheral reseeds it
+            RNG->SR = 0;
+            RNG->CR &= ~RNG_CR_RNGEN;
+            RNG->CR |= RNG_CR_RNGEN;
+        } else if (status & RNG_SR_CEIS) {
+            // The RNG clock dipped too low, the next value is fine again
+            RNG->SR = 0;
+        } else if (status & RNG_SR_DRDY) {
+            last_value = RNG->DR;
+            return last_value;
+        }
+    }
+
+    // No value came, for instance because the RNG clock is misconfigured, so carry on from the last one instead of hanging
+    random_xorshift_fill(&last_value, &last_value, sizeof(last_value));
+    return last_value;
+}
+
+void random_driver_fill(void *data, size_t size) {
+    uint8_t *bytes = data;
+    while (size > 0) {
+        // A new word is ready about 40 RNG clocks after the last one was read
+        uint32_t value = rng_read();
+        size_t   count = size < sizeof(value) ? size : sizeof(value);
+        memcpy(bytes, &value, count);
+        bytes += count;
+        size -= count;
+    }
+}
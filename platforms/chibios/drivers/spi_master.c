@@ -20,6 +20,15 @@
 
 static pin_t currentSlavePin = NO_PIN;
 
+// Lets the bus be shared with other threads, such as the RGB matrix flush thread
+#if SPI_USE_MUTUAL_EXCLUSION
+#    define spi_lock() spiAcquireBus(&SPI_DRIVER)
+#    define spi_unlock() spiReleaseBus(&SPI_DRIVER)
+#else
+#    define spi_lock()
+#    define spi_unlock()
+#endif
+
 #if defined(K20x) || defined(KL2x)
 static SPIConfig spiConfig = {NULL, 0, 0, 0};
 #else
@@ -50,7 +59,7 @@ __attribute__((weak)) void spi_init(void) {
 }
 
 bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
-    if (currentSlavePin != NO_PIN || slavePin == NO_PIN) {
+    if (slavePin == NO_PIN) {
         return false;
     }
 
@@ -63,6 +72,13 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
         return false;
     }
 
+    // held until spi_stop()
+    spi_lock();
+    if (currentSlavePin != NO_PIN) {
+        spi_unlock();
+        return false;
+    }
+
 #if defined(K20x) || defined(KL2x)
     spiConfig.tar0 = SPIx_CTARn_FMSZ(7) | SPIx_CTARn_ASC(1);
 
@@ -198,5 +214,6 @@ void spi_stop(void) {
         spiUnselect(&SPI_DRIVER);
         spiStop(&SPI_DRIVER);
         currentSlavePin = NO_PIN;
+        spi_unlock();
     }
 }
@@ -2,6 +2,7 @@
 #include "ws2812.h"
 #include <ch.h>
 #include <hal.h>
+#include <string.h>
 
 /* Adapted from https://github.com/bigjosh/SimpleNeoPixelDemo/ */
 
@@ -76,6 +77,23 @@ void sendByte(uint8_t byte) {
 
 void ws2812_init(void) { palSetLineMode(RGB_DI_PIN, WS2812_OUTPUT_MODE); }
 
+#ifdef WS2812_BITBANG_SKIP_UNCHANGED
+// Bit-banging can't be handed off to DMA, so the next best thing is not to do it when nothing changed.
+// Only safe when the LEDs hold their colors, which is why it has to be asked for.
+static LED_TYPE last_frame[RGBLED_NUM];
+static uint16_t last_leds = 0;
+
+static bool frame_unchanged(LED_TYPE *ledarray, uint16_t leds) {
+    if (leds > RGBLED_NUM) return false;
+    bool unchanged = leds == last_leds && memcmp(ledarray, last_frame, leds * sizeof(LED_TYPE)) == 0;
+    if (!unchanged) {
+        memcpy(last_frame, ledarray, leds * sizeof(LED_TYPE));
+        last_leds = leds;
+    }
+    return unchanged;
+}
+#endif
+
 // Setleds for standard RGB
 void ws2812_setleds(LED_TYPE *ledarray, uint16_t leds) {
     static bool s_init = false;
@@ -84,6 +102,10 @@ void ws2812_setleds(LED_TYPE *ledarray, uint16_t leds) {
         s_init = true;
     }
 
+#ifdef WS2812_BITBANG_SKIP_UNCHANGED
+    if (frame_unchanged(ledarray, leds)) return;
+#endif
+
     // this code is very time dependent, so we need to disable interrupts
     chSysLock();
 
@@ -80,7 +80,23 @@
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * 1250))
 #define PREAMBLE_SIZE 4
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+#define TXBUF_SIZE (PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE)
+
+// Without the circular buffer or WS2812_SPI_SYNC the transfer runs in the background, so
+// a new frame is encoded into a back buffer while DMA is still reading the front one
+#if !defined(WS2812_SPI_USE_CIRCULAR_BUFFER) && !defined(WS2812_SPI_SYNC)
+#    define WS2812_SPI_DOUBLE_BUFFER
+#endif
+
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+static uint8_t  txbufs[2][TXBUF_SIZE] = {{0}};
+static uint8_t* txbuf       = txbufs[0];  // back buffer, encoded into by ws2812_setleds
+static uint8_t* txbuf_front = txbufs[1];  // front buffer, read by the DMA
+static bool     tx_busy     = false;      // a transfer is running
+static bool     tx_pending  = false;      // the back buffer holds a frame waiting for the transfer to end
+#else
+static uint8_t txbuf[TXBUF_SIZE] = {0};
+#endif
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
@@ -118,6 +134,29 @@ static void set_led_color_rgb(LED_TYPE color, int pos) {
 #endif
 }
 
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+static void swap_and_send_i(void) {
+    uint8_t* sent = txbuf_front;
+    txbuf_front   = txbuf;
+    txbuf         = sent;
+    tx_busy       = true;
+    tx_pending    = false;
+    spiStartSendI(&WS2812_SPI, TXBUF_SIZE, txbuf_front);
+}
+
+// Called from the SPI interrupt once the front buffer is out, starts on the frame that came in meanwhile if there is one
+static void ws2812_spi_end_cb(SPIDriver* spip) {
+    (void)spip;
+    chSysLockFromISR();
+    if (tx_pending) {
+        swap_and_send_i();
+    } else {
+        tx_busy = false;
+    }
+    chSysUnlockFromISR();
+}
+#endif
+
 void ws2812_init(void) {
     palSetLineMode(RGB_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
 
@@ -126,13 +165,17 @@ void ws2812_init(void) {
 #endif  // WS2812_SPI_SCK_PIN
 
     // TODO: more dynamic baudrate
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+    static const SPIConfig spicfg = {WS2812_SPI_BUFFER_MODE, ws2812_spi_end_cb, PAL_PORT(RGB_DI_PIN), PAL_PAD(RGB_DI_PIN), WS2812_SPI_DIVISOR_CR1_BR_X};
+#else
     static const SPIConfig spicfg = {WS2812_SPI_BUFFER_MODE, NULL, PAL_PORT(RGB_DI_PIN), PAL_PAD(RGB_DI_PIN), WS2812_SPI_DIVISOR_CR1_BR_X};
+#endif
 
     spiAcquireBus(&WS2812_SPI);     /* Acquire ownership of the bus.    */
     spiStart(&WS2812_SPI, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI, sizeof(txbuf) / sizeof(txbuf[0]), txbuf);
+    spiStartSend(&WS2812_SPI, TXBUF_SIZE, txbuf);
 #endif
 }
 
@@ -143,17 +186,31 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
         s_init = true;
     }
 
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+    // Take the back buffer back, a frame still waiting in it is replaced by this one
+    chSysLock();
+    tx_pending = false;
+    chSysUnlock();
+#endif
+
     for (uint8_t i = 0; i < leds; i++) {
         set_led_color_rgb(ledarray[i], i);
     }
 
-    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
-    // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
+    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, so the frame is handed to DMA and this returns at once.
+    // If the previous frame is still going out, the end callback starts on this one right after it.
+    // WS2812_SPI_SYNC sends synchronously instead.
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI, sizeof(txbuf) / sizeof(txbuf[0]), txbuf);
+    spiSend(&WS2812_SPI, TXBUF_SIZE, txbuf);
 #    else
-    spiStartSend(&WS2812_SPI, sizeof(txbuf) / sizeof(txbuf[0]), txbuf);
+    chSysLock();
+    if (tx_busy) {
+        tx_pending = true;
+    } else {
+        swap_and_send_i();
+    }
+    chSysUnlock();
 #    endif
 #endif
 }
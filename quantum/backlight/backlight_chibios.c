@@ -21,6 +21,53 @@
 #    define BACKLIGHT_PWM_CHANNEL 3
 #endif
 
+// Several pins, each on its own channel of BACKLIGHT_PWM_DRIVER
+#ifdef BACKLIGHT_PINS
+#    ifndef BACKLIGHT_PWM_CHANNELS
+#        error "BACKLIGHT_PINS requires BACKLIGHT_PWM_CHANNELS, with the timer channel of each pin in the same order"
+#    endif
+#else
+#    define BACKLIGHT_PINS \
+        { BACKLIGHT_PIN }
+#    define BACKLIGHT_PWM_CHANNELS \
+        { BACKLIGHT_PWM_CHANNEL }
+#endif
+
+#ifdef BACKLIGHT_BREATHING_DMA
+#    ifndef BACKLIGHT_BREATHING
+#        error "BACKLIGHT_BREATHING_DMA requires BACKLIGHT_BREATHING"
+#    endif
+// Timer that paces the breathing steps, needs HAL_USE_GPT and STM32_GPT_USE_TIMx in halconf.h and mcuconf.h
+#    ifndef BACKLIGHT_BREATHING_GPT_DRIVER
+#        define BACKLIGHT_BREATHING_GPT_DRIVER GPTD6
+#    endif
+#    ifndef BACKLIGHT_BREATHING_GPT_FREQUENCY
+#        define BACKLIGHT_BREATHING_GPT_FREQUENCY 10000
+#    endif
+#    ifndef BACKLIGHT_DMA_STREAM
+#        define BACKLIGHT_DMA_STREAM STM32_DMA1_STREAM3  // DMA Stream for the pacing timer's TIMx_UP
+#    endif
+#    ifndef BACKLIGHT_DMA_CHANNEL
+#        define BACKLIGHT_DMA_CHANNEL 0  // DMA Channel for the pacing timer's TIMx_UP
+#    endif
+#    if (STM32_DMA_SUPPORTS_DMAMUX == TRUE) && !defined(BACKLIGHT_DMAMUX_ID) && !defined(BACKLIGHT_DMAMUX_IDS)
+#        error "please consult your MCU's datasheet and specify in your config.h: #define BACKLIGHT_DMAMUX_ID STM32_DMAMUX1_TIM?_UP"
+#    endif
+// One stream per backlight channel, the first one is requested by the pacing timer's update event and the n-th one after it by its CCn event
+#    ifndef BACKLIGHT_DMA_STREAMS
+#        define BACKLIGHT_DMA_STREAMS \
+            { BACKLIGHT_DMA_STREAM }
+#    endif
+#    ifndef BACKLIGHT_DMA_CHANNELS
+#        define BACKLIGHT_DMA_CHANNELS \
+            { BACKLIGHT_DMA_CHANNEL }
+#    endif
+#    if (STM32_DMA_SUPPORTS_DMAMUX == TRUE) && !defined(BACKLIGHT_DMAMUX_IDS)
+#        define BACKLIGHT_DMAMUX_IDS \
+            { BACKLIGHT_DMAMUX_ID }
+#    endif
+#endif
+
 // Support for pins which are on TIM1_CH1N - requires STM32_PWM_USE_ADVANCED
 #ifdef BACKLIGHT_PWM_COMPLEMENTARY_OUTPUT
 #    if BACKLIGHT_ON_STATE == 1
@@ -37,7 +84,7 @@
 #endif
 
 static PWMConfig pwmCFG = {0xFFFF, /* PWM clock frequency  */
-                           256,    /* PWM period (in ticks) 1S (1/10kHz=0.1mS 0.1ms*10000 ticks=1S) */
+                           256,    /* PWM period (in ticks), so duty cycles have 8 bit resolution at about 256Hz */
                            NULL,   /* Breathing Callback */
                            {       /* Default all channels to disabled - Channels will be configured durring init */
                             {PWM_OUTPUT_DISABLED, NULL},
@@ -47,6 +94,13 @@ static PWMConfig pwmCFG = {0xFFFF, /* PWM clock frequency  */
                            0, /* HW dependent part.*/
                            0};
 
+static const pin_t   backlight_pins[]     = BACKLIGHT_PINS;
+static const uint8_t backlight_channels[] = BACKLIGHT_PWM_CHANNELS;
+#define BACKLIGHT_PWM_COUNT (sizeof(backlight_pins) / sizeof(pin_t))
+
+_Static_assert(sizeof(backlight_channels) == BACKLIGHT_PWM_COUNT, "BACKLIGHT_PWM_CHANNELS needs one channel for each of BACKLIGHT_PINS");
+_Static_assert(BACKLIGHT_PWM_COUNT <= 4, "A timer has at most 4 channels for BACKLIGHT_PINS");
+
 // See http://jared.geek.nz/2013/feb/linear-led-pwm
 static uint16_t cie_lightness(uint16_t v) {
     if (v <= 5243)     // if below 8% of max
@@ -69,13 +123,15 @@ static uint32_t rescale_limit_val(uint32_t val) {
 }
 
 void backlight_init_ports(void) {
+    for (uint8_t i = 0; i < BACKLIGHT_PWM_COUNT; i++) {
 #ifdef USE_GPIOV1
-    palSetPadMode(PAL_PORT(BACKLIGHT_PIN), PAL_PAD(BACKLIGHT_PIN), PAL_MODE_STM32_ALTERNATE_PUSHPULL);
+        palSetPadMode(PAL_PORT(backlight_pins[i]), PAL_PAD(backlight_pins[i]), PAL_MODE_STM32_ALTERNATE_PUSHPULL);
 #else
-    palSetPadMode(PAL_PORT(BACKLIGHT_PIN), PAL_PAD(BACKLIGHT_PIN), PAL_MODE_ALTERNATE(BACKLIGHT_PAL_MODE));
+        palSetPadMode(PAL_PORT(backlight_pins[i]), PAL_PAD(backlight_pins[i]), PAL_MODE_ALTERNATE(BACKLIGHT_PAL_MODE));
 #endif
+        pwmCFG.channels[backlight_channels[i] - 1].mode = PWM_OUTPUT_MODE;
+    }
 
-    pwmCFG.channels[BACKLIGHT_PWM_CHANNEL - 1].mode = PWM_OUTPUT_MODE;
     pwmStart(&BACKLIGHT_PWM_DRIVER, &pwmCFG);
 
     backlight_set(get_backlight_level());
@@ -92,15 +148,21 @@ void backlight_set(uint8_t level) {
 
     if (level == 0) {
         // Turn backlight off
-        pwmDisableChannel(&BACKLIGHT_PWM_DRIVER, BACKLIGHT_PWM_CHANNEL - 1);
+        for (uint8_t i = 0; i < BACKLIGHT_PWM_COUNT; i++) {
+            pwmDisableChannel(&BACKLIGHT_PWM_DRIVER, backlight_channels[i] - 1);
+        }
     } else {
         // Turn backlight on
         uint32_t duty = (uint32_t)(cie_lightness(rescale_limit_val(0xFFFF * (uint32_t)level / BACKLIGHT_LEVELS)));
-        pwmEnableChannel(&BACKLIGHT_PWM_DRIVER, BACKLIGHT_PWM_CHANNEL - 1, PWM_FRACTION_TO_WIDTH(&BACKLIGHT_PWM_DRIVER, 0xFFFF, duty));
+        for (uint8_t i = 0; i < BACKLIGHT_PWM_COUNT; i++) {
+            pwmEnableChannel(&BACKLIGHT_PWM_DRIVER, backlight_channels[i] - 1, PWM_FRACTION_TO_WIDTH(&BACKLIGHT_PWM_DRIVER, 0xFFFF, duty));
+        }
     }
 }
 
+#ifndef BACKLIGHT_BREATHING_DMA
 void backlight_task(void) {}
+#endif
 
 #ifdef BACKLIGHT_BREATHING
 
@@ -111,6 +173,106 @@ void backlight_task(void) {}
  */
 static const uint8_t breathing_table[BREATHING_STEPS] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 3, 4, 5, 6, 8, 10, 12, 15, 17, 20, 24, 28, 32, 36, 41, 46, 51, 57, 63, 70, 76, 83, 91, 98, 106, 113, 121, 129, 138, 146, 154, 162, 170, 178, 185, 193, 200, 207, 213, 220, 225, 231, 235, 240, 244, 247, 250, 252, 253, 254, 255, 254, 253, 252, 250, 247, 244, 240, 235, 231, 225, 220, 213, 207, 200, 193, 185, 178, 170, 162, 154, 146, 138, 129, 121, 113, 106, 98, 91, 83, 76, 70, 63, 57, 51, 46, 41, 36, 32, 28, 24, 20, 17, 15, 12, 10, 8, 6, 5, 4, 3, 2, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
+// Use this before the cie_lightness function.
+static inline uint16_t scale_backlight(uint16_t v) { return v / BACKLIGHT_LEVELS * get_backlight_level(); }
+
+#    ifdef BACKLIGHT_BREATHING_DMA
+
+/* The breathing curve at the current level, as compare values. A pacing timer requests
+ * a DMA transfer of the next one into the PWM compare register every breathing_period / BREATHING_STEPS,
+ * so the CPU only gets involved when the level or the period changes.
+ * With several pins every channel has its own stream reading the same curve, the pacing timer's
+ * update event requests the first one and its compare events, left at 0, the others right after it.
+ */
+static uint32_t breathing_waveform[BREATHING_STEPS];
+static bool     breathing_running = false;
+static uint8_t  breathing_level;
+static uint8_t  breathing_waveform_period;
+
+static const stm32_dma_stream_t *const backlight_dma_streams[]  = BACKLIGHT_DMA_STREAMS;
+static const uint8_t                   backlight_dma_channels[] = BACKLIGHT_DMA_CHANNELS;
+#        if (STM32_DMA_SUPPORTS_DMAMUX == TRUE)
+static const uint8_t backlight_dmamux_ids[] = BACKLIGHT_DMAMUX_IDS;
+_Static_assert(sizeof(backlight_dmamux_ids) == BACKLIGHT_PWM_COUNT, "BACKLIGHT_DMAMUX_IDS needs one request for each of BACKLIGHT_PINS");
+#        endif
+_Static_assert(sizeof(backlight_dma_streams) / sizeof(backlight_dma_streams[0]) == BACKLIGHT_PWM_COUNT, "BACKLIGHT_DMA_STREAMS needs one stream for each of BACKLIGHT_PINS");
+_Static_assert(sizeof(backlight_dma_channels) == BACKLIGHT_PWM_COUNT, "BACKLIGHT_DMA_CHANNELS needs one channel for each of BACKLIGHT_PINS");
+
+static GPTConfig breathing_gpt_config = {
+    .frequency = BACKLIGHT_BREATHING_GPT_FREQUENCY,
+    .callback  = NULL,
+    .cr2       = 0,
+    .dier      = TIM_DIER_UDE,  // DMA on update event for the next step, the compare events are added for each further pin
+};
+
+static void breathing_fill_waveform(void) {
+    breathing_level = get_backlight_level();
+    for (uint8_t i = 0; i < BREATHING_STEPS; i++) {
+        uint32_t duty         = cie_lightness(rescale_limit_val(scale_backlight(breathing_table[i] * 256)));
+        breathing_waveform[i] = PWM_FRACTION_TO_WIDTH(&BACKLIGHT_PWM_DRIVER, 0xFFFF, duty);
+    }
+}
+
+static gptcnt_t breathing_interval(void) {
+    breathing_waveform_period = get_breathing_period();
+    return (uint32_t)breathing_waveform_period * BACKLIGHT_BREATHING_GPT_FREQUENCY / BREATHING_STEPS;
+}
+
+bool is_breathing(void) { return breathing_running; }
+
+void breathing_enable(void) {
+    if (breathing_running) return;
+    breathing_running = true;
+    breathing_fill_waveform();
+
+    // The waveform is rewritten in place when the level changes, the DMA just picks up the new values on its next loop
+    for (uint8_t i = 0; i < BACKLIGHT_PWM_COUNT; i++) {
+        const stm32_dma_stream_t *stream = backlight_dma_streams[i];
+        dmaStreamAlloc(stream - STM32_DMA_STREAM(0), 10, NULL, NULL);
+        dmaStreamSetPeripheral(stream, &(BACKLIGHT_PWM_DRIVER.tim->CCR[backlight_channels[i] - 1]));
+        dmaStreamSetMemory0(stream, breathing_waveform);
+        dmaStreamSetTransactionSize(stream, BREATHING_STEPS);
+        dmaStreamSetMode(stream, STM32_DMA_CR_CHSEL(backlight_dma_channels[i]) | STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(0));
+#        if (STM32_DMA_SUPPORTS_DMAMUX == TRUE)
+        dmaSetRequestSource(stream, backlight_dmamux_ids[i]);
+#        endif
+        dmaStreamEnable(stream);
+
+        pwmEnableChannel(&BACKLIGHT_PWM_DRIVER, backlight_channels[i] - 1, breathing_waveform[0]);
+        if (i > 0) breathing_gpt_config.dier |= TIM_DIER_CC1DE << (i - 1);
+    }
+    gptStart(&BACKLIGHT_BREATHING_GPT_DRIVER, &breathing_gpt_config);
+    gptStartContinuous(&BACKLIGHT_BREATHING_GPT_DRIVER, breathing_interval());
+}
+
+void breathing_disable(void) {
+    if (breathing_running) {
+        breathing_running = false;
+        gptStopTimer(&BACKLIGHT_BREATHING_GPT_DRIVER);
+        gptStop(&BACKLIGHT_BREATHING_GPT_DRIVER);
+        for (uint8_t i = 0; i < BACKLIGHT_PWM_COUNT; i++) {
+            dmaStreamDisable(backlight_dma_streams[i]);
+            dmaStreamFree(backlight_dma_streams[i]);
+        }
+    }
+
+    // Restore backlight level
+    backlight_set(get_backlight_level());
+}
+
+void backlight_task(void) {
+    if (!breathing_running) return;
+
+    if (breathing_level != get_backlight_level()) {
+        breathing_fill_waveform();
+    }
+    if (breathing_waveform_period != get_breathing_period()) {
+        gptChangeInterval(&BACKLIGHT_BREATHING_GPT_DRIVER, breathing_interval());
+    }
+}
+
+#    else
+
 void breathing_callback(PWMDriver *pwmp);
 
 bool is_breathing(void) { return pwmCFG.callback != NULL; }
@@ -128,9 +290,6 @@ void breathing_disable(void) {
     backlight_set(get_backlight_level());
 }
 
-// Use this before the cie_lightness function.
-static inline uint16_t scale_backlight(uint16_t v) { return v / BACKLIGHT_LEVELS * get_backlight_level(); }
-
 void breathing_callback(PWMDriver *pwmp) {
     uint8_t  breathing_period = get_breathing_period();
     uint16_t interval         = (uint16_t)breathing_period * 256 / BREATHING_STEPS;
@@ -142,10 +301,14 @@ void breathing_callback(PWMDriver *pwmp) {
     uint32_t duty                     = cie_lightness(rescale_limit_val(scale_backlight(breathing_table[index] * 256)));
 
     chSysLockFromISR();
-    pwmEnableChannelI(pwmp, BACKLIGHT_PWM_CHANNEL - 1, PWM_FRACTION_TO_WIDTH(&BACKLIGHT_PWM_DRIVER, 0xFFFF, duty));
+    for (uint8_t i = 0; i < BACKLIGHT_PWM_COUNT; i++) {
+        pwmEnableChannelI(pwmp, backlight_channels[i] - 1, PWM_FRACTION_TO_WIDTH(&BACKLIGHT_PWM_DRIVER, 0xFFFF, duty));
+    }
     chSysUnlockFromISR();
 }
 
+#    endif  // BACKLIGHT_BREATHING_DMA
+
 // TODO: integrate generic pulse solution
 void breathing_pulse(void) {
     backlight_set(is_backlight_enabled() ? 0 : BACKLIGHT_LEVELS);
@@ -18,46 +18,30 @@
 #include "led_tables.h"
 #include "progmem.h"
 
-RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
-    RGB      rgb;
-    uint8_t  region, remainder, p, q, t;
-    uint16_t h, s, v;
+// Converts a single color, expects v to already have the CIE curve applied
+static inline RGB hsv_to_rgb_kernel(uint8_t h, uint8_t s, uint8_t v) {
+    RGB     rgb;
+    uint8_t region, remainder, p, q, t;
 
-    if (hsv.s == 0) {
-#ifdef USE_CIE1931_CURVE
-        if (use_cie) {
-            rgb.r = rgb.g = rgb.b = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-        } else {
-            rgb.r = hsv.v;
-            rgb.g = hsv.v;
-            rgb.b = hsv.v;
-        }
-#else
-        rgb.r = hsv.v;
-        rgb.g = hsv.v;
-        rgb.b = hsv.v;
-#endif
+    if (s == 0) {
+        rgb.r = v;
+        rgb.g = v;
+        rgb.b = v;
         return rgb;
     }
 
-    h = hsv.h;
-    s = hsv.s;
-#ifdef USE_CIE1931_CURVE
-    if (use_cie) {
-        v = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
-    } else {
-        v = hsv.v;
-    }
-#else
-    v = hsv.v;
-#endif
-
-    region    = h * 6 / 255;
+    // h * 6 / 255 without a division
+    region    = ((uint16_t)h * 6 + (((uint16_t)h * 6) >> 8) + 1) >> 8;
     remainder = (h * 2 - region * 85) * 3;
 
-    p = (v * (255 - s)) >> 8;
-    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
-    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+    // The products below never exceed 16 bits, so two of them are computed
+    // with a single 32 bit multiply, one per half word
+    uint32_t sr = (uint32_t)s * (((uint32_t)remainder << 16) | (uint8_t)(255 - remainder));
+    uint32_t qt = (uint32_t)v * (((uint32_t)(255 - (sr >> 24)) << 16) | (255 - ((sr >> 8) & 0xFF)));
+
+    p = ((uint16_t)v * (255 - s)) >> 8;
+    q = qt >> 24;
+    t = qt >> 8;
 
     switch (region) {
         case 6:
@@ -96,6 +80,52 @@ RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     return rgb;
 }
 
+RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
+#ifdef USE_CIE1931_CURVE
+    if (use_cie) {
+        return hsv_to_rgb_kernel(hsv.h, hsv.s, pgm_read_byte(&CIE1931_CURVE[hsv.v]));
+    }
+#endif
+    return hsv_to_rgb_kernel(hsv.h, hsv.s, hsv.v);
+}
+
+static void hsv_to_rgb_batch_impl(const HSV *hsv, RGB *rgb, uint8_t count, bool use_cie) {
+#ifdef USE_CIE1931_CURVE
+    if (use_cie) {
+        for (uint8_t i = 0; i < count; i++) {
+            rgb[i] = hsv_to_rgb_kernel(hsv[i].h, hsv[i].s, pgm_read_byte(&CIE1931_CURVE[hsv[i].v]));
+        }
+        return;
+    }
+#endif
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = hsv_to_rgb_kernel(hsv[i].h, hsv[i].s, hsv[i].v);
+    }
+}
+
+#ifdef USE_CIE1931_CURVE_16
+// Converts at full value, then scales by the 16-bit CIE curve, keeping the fraction the 8-bit path rounds off
+static inline RGB16 hsv_to_rgb16_kernel(uint8_t h, uint8_t s, uint8_t v) {
+    RGB      rgb   = hsv_to_rgb_kernel(h, s, 255);
+    uint16_t level = pgm_read_word(&CIE1931_CURVE_16[v]);
+    RGB16    out;
+
+    // c + (c >> 7) maps 0..255 onto 0..256, so a full channel comes out at exactly level and an empty one at 0
+    out.r = ((uint32_t)(rgb.r + (rgb.r >> 7)) * level) >> 8;
+    out.g = ((uint32_t)(rgb.g + (rgb.g >> 7)) * level) >> 8;
+    out.b = ((uint32_t)(rgb.b + (rgb.b >> 7)) * level) >> 8;
+    return out;
+}
+
+RGB16 hsv_to_rgb16(HSV hsv) { return hsv_to_rgb16_kernel(hsv.h, hsv.s, hsv.v); }
+
+void hsv_to_rgb16_batch(const HSV *hsv, RGB16 *rgb, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = hsv_to_rgb16_kernel(hsv[i].h, hsv[i].s, hsv[i].v);
+    }
+}
+#endif
+
 RGB hsv_to_rgb(HSV hsv) {
 #ifdef USE_CIE1931_CURVE
     return hsv_to_rgb_impl(hsv, true);
@@ -106,6 +136,16 @@ RGB hsv_to_rgb(HSV hsv) {
 
 RGB hsv_to_rgb_nocie(HSV hsv) { return hsv_to_rgb_impl(hsv, false); }
 
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_batch_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+#endif
+}
+
+void hsv_to_rgb_nocie_batch(const HSV *hsv, RGB *rgb, uint8_t count) { hsv_to_rgb_batch_impl(hsv, rgb, count, false); }
+
 #ifdef RGBW
 #    ifndef MIN
 #        define MIN(a, b) ((a) < (b) ? (a) : (b))
@@ -143,8 +143,19 @@ typedef struct PACKED {
 #    pragma pack(pop)
 #endif
 
+// A color in 8.8 fixed point, keeping the fraction of a PWM step for dithering
+typedef struct {
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+} RGB16;
+
 RGB hsv_to_rgb(HSV hsv);
 RGB hsv_to_rgb_nocie(HSV hsv);
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count);
+void hsv_to_rgb_nocie_batch(const HSV *hsv, RGB *rgb, uint8_t count);
+RGB16 hsv_to_rgb16(HSV hsv);
+void hsv_to_rgb16_batch(const HSV *hsv, RGB16 *rgb, uint8_t count);
 #ifdef RGBW
 void convert_rgb_to_rgbw(LED_TYPE *led);
 #endif
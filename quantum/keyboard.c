@@ -106,9 +106,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
+#ifdef RANDOM_ENABLE
+#    include "random.h"
+#endif
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
 #endif
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_KEY_EVENT_TIMESTAMPS)
+#    include "split_util.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) { return last_input_modification_time; }
@@ -124,6 +130,34 @@ uint32_t        last_encoder_activity_time(void) { return last_encoder_modificat
 uint32_t        last_encoder_activity_elapsed(void) { return timer_elapsed32(last_encoder_modification_time); }
 void            last_encoder_activity_trigger(void) { last_encoder_modification_time = last_input_modification_time = timer_read32(); }
 
+/** \brief Get the timestamp for a key event on the given matrix row
+ *
+ * On split keyboards with SPLIT_KEY_EVENT_TIMESTAMPS, keys on the slave half use the slave-side scan time
+ * instead of the time the master got around to processing them. Event times are kept from going backwards,
+ * as tapping and combo decisions assume events arrive in order.
+ */
+static uint16_t key_event_time(uint8_t row) {
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_KEY_EVENT_TIMESTAMPS)
+    static uint16_t last_time = 0;
+
+    uint16_t now  = timer_read();
+    uint16_t time = split_key_event_time(row);
+    uint16_t age  = TIMER_DIFF_16(now, time);
+    if (age > (UINT16_MAX / 2)) {
+        // Sync timer jitter can put the slave slightly ahead of the master
+        time = now;
+        age  = 0;
+    }
+    if (age > TIMER_DIFF_16(now, last_time)) {
+        time = last_time;
+    }
+    last_time = time;
+    return time | 1; /* time should not be 0 */
+#else
+    return timer_read() | 1; /* time should not be 0 */
+#endif
+}
+
 // Only enable this if console is enabled to print to
 #if defined(DEBUG_MATRIX_SCAN_RATE)
 static uint32_t matrix_timer           = 0;
@@ -316,6 +350,9 @@ void keyboard_init(void) {
 #if defined(CRC_ENABLE)
     crc_init();
 #endif
+#ifdef RANDOM_ENABLE
+    random_init();
+#endif
 #ifdef QWIIC_ENABLE
     qwiic_init();
 #endif
@@ -404,6 +441,9 @@ void keyboard_task(void) {
 
     uint8_t matrix_changed = matrix_scan();
     if (matrix_changed) last_matrix_activity_trigger();
+#ifdef RANDOM_ENABLE
+    if (matrix_changed) random_add_entropy(timer_read32());
+#endif
 
     for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
         matrix_row    = matrix_get_row(r);
@@ -420,7 +460,7 @@ void keyboard_task(void) {
                 if (matrix_change & col_mask) {
                     if (should_process_keypress()) {
                         action_exec((keyevent_t){
-                            .key = (keypos_t){.row = r, .col = c}, .pressed = (matrix_row & col_mask), .time = (timer_read() | 1) /* time should not be 0 */
+                            .key = (keypos_t){.row = r, .col = c}, .pressed = (matrix_row & col_mask), .time = key_event_time(r)
                         });
                     }
                     // record a processed key
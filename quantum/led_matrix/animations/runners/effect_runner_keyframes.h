@@ -0,0 +1,17 @@
+#pragma once
+
+static lighting_keyframes_state_t keyframes_state;
+
+bool effect_runner_keyframes(effect_params_t* params, const led_matrix_keyframes_t* keyframes) {
+    LED_MATRIX_USE_LIMITS(led_min, led_max);
+
+    // The frame only moves on before the first slice, so every slice of a frame draws the same one
+    if (params->iter == 0) lighting_keyframes_play(&keyframes_state, keyframes, params->init, g_led_timer, led_matrix_eeconfig.speed);
+
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LED_MATRIX_TEST_LED_FLAGS();
+        uint8_t value = i < keyframes->led_count ? pgm_read_byte(keyframes->palette + keyframes_state.leds[i]) : 0;
+        led_matrix_set_value(i, scale8(value, led_matrix_eeconfig.val));
+    }
+    return led_max < DRIVER_LED_TOTAL;
+}
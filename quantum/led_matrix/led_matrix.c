@@ -153,36 +153,72 @@ void eeconfig_debug_led_matrix(void) {
 __attribute__((weak)) uint8_t led_matrix_map_row_column_to_led_kb(uint8_t row, uint8_t column, uint8_t *led_i) { return 0; }
 
 uint8_t led_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i) {
-    uint8_t led_count = led_matrix_map_row_column_to_led_kb(row, column, led_i);
-    uint8_t led_index = g_led_config.matrix_co[row][column];
-    if (led_index != NO_LED) {
-        led_i[led_count] = led_index;
-        led_count++;
+    return lighting_map_row_column_to_led(row, column, led_i, led_matrix_map_row_column_to_led_kb(row, column, led_i));
+}
+
+#ifdef LED_MATRIX_DITHER
+// The values as set with the CIE curve applied in 8.8 fixed point, and the fraction of a step each LED still owes from earlier frames
+static uint16_t led_dither_level[DRIVER_LED_TOTAL];
+static uint8_t  led_dither_error[DRIVER_LED_TOTAL];
+
+static void led_matrix_dither_init(void) {
+    // Start every LED at a different point of its cycle, so LEDs on the same fractional level don't all step up in the same frame
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        led_dither_error[i] = i * 157;
     }
-    return led_count;
 }
 
-void led_matrix_update_pwm_buffers(void) { led_matrix_driver.flush(); }
+// Sends this frame's 8-bit share of every level to the driver, runs once per flush even when nothing changed
+static void led_matrix_dither(void) {
+#    if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+    uint8_t count = is_keyboard_left() ? k_led_matrix_split[0] : k_led_matrix_split[1];
+#    else
+    uint8_t count = DRIVER_LED_TOTAL;
+#    endif
+    for (uint8_t i = 0; i < count; i++) {
+        led_matrix_driver.set_value(i, dither8(led_dither_level[i], &led_dither_error[i]));
+    }
+}
+#endif  // LED_MATRIX_DITHER
+
+void led_matrix_update_pwm_buffers(void) {
+#ifdef LED_MATRIX_DITHER
+    led_matrix_dither();
+#endif
+    led_matrix_driver.flush();
+}
 
 void led_matrix_set_value(int index, uint8_t value) {
-#if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+#ifdef LED_MATRIX_DITHER
+#    if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+    if (!is_keyboard_left()) {
+        if (index < k_led_matrix_split[0]) return;
+        index -= k_led_matrix_split[0];
+    } else if (index >= k_led_matrix_split[0]) {
+        return;
+    }
+#    endif
+    if (index >= 0 && index < DRIVER_LED_TOTAL) led_dither_level[index] = pgm_read_word(&CIE1931_CURVE_16[value]);
+#else
+#    if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
     if (!is_keyboard_left() && index >= k_led_matrix_split[0])
-#    ifdef USE_CIE1931_CURVE
+#        ifdef USE_CIE1931_CURVE
         led_matrix_driver.set_value(index - k_led_matrix_split[0], pgm_read_byte(&CIE1931_CURVE[value]));
-#    else
+#        else
         led_matrix_driver.set_value(index - k_led_matrix_split[0], value);
-#    endif
+#        endif
     else if (is_keyboard_left() && index < k_led_matrix_split[0])
-#endif
-#ifdef USE_CIE1931_CURVE
+#    endif
+#    ifdef USE_CIE1931_CURVE
         led_matrix_driver.set_value(index, pgm_read_byte(&CIE1931_CURVE[value]));
-#else
+#    else
     led_matrix_driver.set_value(index, value);
+#    endif
 #endif
 }
 
 void led_matrix_set_value_all(uint8_t value) {
-#if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+#if (defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)) || defined(LED_MATRIX_DITHER)
     for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) led_matrix_set_value(i, value);
 #else
 #    ifdef USE_CIE1931_CURVE
@@ -214,22 +250,7 @@ void process_led_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = led_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2);  // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
-    }
+    lighting_hits_record(&last_hit_buffer, led, led_count, 0);
 #endif  // LED_MATRIX_KEYREACTIVE_ENABLED
 
 #if defined(LED_MATRIX_FRAMEBUFFER_EFFECTS) && !defined(DISABLE_LED_MATRIX_TYPING_HEATMAP)
@@ -256,25 +277,12 @@ static void led_task_timers(void) {
 
     // Update double buffer timers
 #if LED_DISABLE_TIMEOUT > 0
-    if (led_anykey_timer < UINT32_MAX) {
-        if (UINT32_MAX - deltaTime < led_anykey_timer) {
-            led_anykey_timer = UINT32_MAX;
-        } else {
-            led_anykey_timer += deltaTime;
-        }
-    }
+    lighting_timer_add(&led_anykey_timer, deltaTime);
 #endif  // LED_DISABLE_TIMEOUT > 0
 
     // Update double buffer last hit timers
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
-    }
+    lighting_hits_age(&last_hit_buffer, deltaTime);
 #endif  // LED_MATRIX_KEYREACTIVE_ENABLED
 }
 
@@ -431,16 +439,13 @@ __attribute__((weak)) void led_matrix_indicators_advanced_user(uint8_t led_min,
 void led_matrix_init(void) {
     led_matrix_driver.init();
 
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        g_last_hit_tracker.tick[i] = UINT16_MAX;
-    }
+#ifdef LED_MATRIX_DITHER
+    led_matrix_dither_init();
+#endif  // LED_MATRIX_DITHER
 
-    last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
+#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
+    lighting_hits_init(&g_last_hit_tracker);
+    lighting_hits_init(&last_hit_buffer);
 #endif  // LED_MATRIX_KEYREACTIVE_ENABLED
 
     if (!eeconfig_is_enabled()) {
@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "led_matrix_types.h"
+#include "lighting.h"
 #include "quantum.h"
 #include "led_matrix_legacy_enables.h"
 
@@ -38,18 +39,14 @@
 #endif
 
 #if defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
-#    define LED_MATRIX_USE_LIMITS(min, max)                        \
-        uint8_t min = LED_MATRIX_LED_PROCESS_LIMIT * params->iter; \
-        uint8_t max = min + LED_MATRIX_LED_PROCESS_LIMIT;          \
-        if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
+#    define LED_MATRIX_USE_LIMITS(min, max) LIGHTING_USE_LIMITS(min, max, LED_MATRIX_LED_PROCESS_LIMIT)
 #else
 #    define LED_MATRIX_USE_LIMITS(min, max) \
         uint8_t min = 0;                    \
         uint8_t max = DRIVER_LED_TOTAL;
 #endif
 
-#define LED_MATRIX_TEST_LED_FLAGS() \
-    if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+#define LED_MATRIX_TEST_LED_FLAGS() LIGHTING_TEST_LED_FLAGS()
 
 enum led_matrix_effects {
     LED_MATRIX_NONE = 0,
@@ -151,8 +148,7 @@ extern const led_matrix_driver_t led_matrix_driver;
 
 extern led_eeconfig_t led_matrix_eeconfig;
 
-extern uint32_t     g_led_timer;
-extern led_config_t g_led_config;
+extern uint32_t g_led_timer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
@@ -40,4 +40,27 @@ const uint8_t CIE1931_CURVE[256] PROGMEM = {
 };
 #endif
 
+#ifdef USE_CIE1931_CURVE_16
+// The same curve in 8.8 fixed point, for dithering the fraction over frames. A lit input never
+// drops below 1.0, so low levels alternate between two lit values instead of blinking off.
+const uint16_t CIE1931_CURVE_16[256] PROGMEM = {
+        0,   256,   256,   256,   256,   256,   256,   256,   256,   256,   284,   312,   340,   369,   397,   426,
+      454,   482,   511,   539,   567,   595,   625,   655,   686,   719,   752,   786,   821,   858,   895,   934,
+      973,  1014,  1056,  1098,  1143,  1188,  1234,  1282,  1331,  1381,  1432,  1484,  1538,  1593,  1649,  1707,
+     1766,  1826,  1888,  1951,  2016,  2082,  2149,  2218,  2288,  2359,  2433,  2507,  2583,  2661,  2740,  2821,
+     2903,  2987,  3073,  3160,  3248,  3339,  3431,  3525,  3620,  3717,  3816,  3917,  4019,  4123,  4229,  4337,
+     4446,  4558,  4671,  4786,  4903,  5021,  5142,  5265,  5389,  5516,  5644,  5775,  5907,  6042,  6178,  6317,
+     6457,  6600,  6745,  6891,  7040,  7191,  7345,  7500,  7658,  7817,  7979,  8143,  8310,  8479,  8649,  8823,
+     8998,  9176,  9356,  9539,  9724,  9911, 10100, 10292, 10487, 10684, 10883, 11085, 11289, 11496, 11705, 11917,
+    12131, 12348, 12568, 12790, 13014, 13241, 13471, 13704, 13939, 14177, 14417, 14661, 14907, 15155, 15407, 15661,
+    15918, 16178, 16441, 16706, 16974, 17245, 17519, 17796, 18076, 18359, 18645, 18933, 19225, 19519, 19817, 20117,
+    20421, 20728, 21037, 21350, 21666, 21985, 22307, 22632, 22960, 23292, 23626, 23964, 24305, 24650, 24997, 25348,
+    25702, 26059, 26420, 26784, 27151, 27521, 27895, 28273, 28653, 29037, 29425, 29816, 30210, 30608, 31009, 31414,
+    31823, 32234, 32650, 33069, 33491, 33917, 34347, 34780, 35217, 35658, 36102, 36550, 37002, 37457, 37916, 38379,
+    38845, 39315, 39789, 40267, 40749, 41234, 41724, 42217, 42714, 43215, 43720, 44229, 44741, 45258, 45779, 46303,
+    46832, 47364, 47901, 48441, 48986, 49535, 50088, 50645, 51206, 51771, 52340, 52914, 53491, 54073, 54659, 55250,
+    55844, 56443, 57046, 57653, 58265, 58881, 59501, 60125, 60754, 61388, 62025, 62667, 63314, 63965, 64620, 65280
+};
+#endif
+
 // clang-format on
@@ -21,3 +21,22 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef USE_CIE1931_CURVE
 extern const uint8_t CIE1931_CURVE[] PROGMEM;
 #endif
+
+#if defined(RGB_MATRIX_DITHER) || defined(LED_MATRIX_DITHER)
+#    define USE_CIE1931_CURVE_16
+#endif
+
+#ifdef USE_CIE1931_CURVE_16
+extern const uint16_t CIE1931_CURVE_16[] PROGMEM;
+
+/* Temporal dithering of an 8.8 fixed point level down to 8 bits. The fraction dropped from
+ * this frame is carried in error and added to the next one, so over a few frames the output
+ * averages out to the exact level.
+ */
+static inline uint8_t dither8(uint16_t level, uint8_t *error) {
+    // level is at most 255.0, so this can't overflow
+    uint16_t sum = level + *error;
+    *error       = sum & 0xFF;
+    return sum >> 8;
+}
+#endif
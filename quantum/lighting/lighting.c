@@ -0,0 +1,126 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lighting.h"
+
+#include <string.h>
+#include "progmem.h"
+
+uint8_t lighting_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i, uint8_t led_count) {
+    uint8_t led_index = g_led_config.matrix_co[row][column];
+    if (led_index != NO_LED) {
+        led_i[led_count] = led_index;
+        led_count++;
+    }
+    return led_count;
+}
+
+void lighting_hits_init(last_hit_t *hits) {
+    hits->count = 0;
+    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
+        hits->tick[i] = UINT16_MAX;
+    }
+}
+
+void lighting_hits_record(last_hit_t *hits, const uint8_t *leds, uint8_t count, uint16_t tick) {
+    if (hits->count + count > LED_HITS_TO_REMEMBER) {
+        memcpy(&hits->x[0], &hits->x[count], LED_HITS_TO_REMEMBER - count);
+        memcpy(&hits->y[0], &hits->y[count], LED_HITS_TO_REMEMBER - count);
+        memcpy(&hits->tick[0], &hits->tick[count], (LED_HITS_TO_REMEMBER - count) * 2);  // 16 bit
+        memcpy(&hits->index[0], &hits->index[count], LED_HITS_TO_REMEMBER - count);
+        hits->count = LED_HITS_TO_REMEMBER - count;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t index      = hits->count;
+        hits->x[index]     = g_led_config.point[leds[i]].x;
+        hits->y[index]     = g_led_config.point[leds[i]].y;
+        hits->index[index] = leds[i];
+        hits->tick[index]  = tick;
+        hits->count++;
+    }
+}
+
+void lighting_hits_age(last_hit_t *hits, uint32_t elapsed) {
+    uint8_t count = hits->count;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (UINT16_MAX - elapsed < hits->tick[i]) {
+            hits->count--;
+            continue;
+        }
+        hits->tick[i] += elapsed;
+    }
+}
+
+void lighting_timer_add(uint32_t *timer, uint32_t elapsed) {
+    if (*timer < UINT32_MAX) {
+        if (UINT32_MAX - elapsed < *timer) {
+            *timer = UINT32_MAX;
+        } else {
+            *timer += elapsed;
+        }
+    }
+}
+
+/* Applies one frame of the stream to leds and returns where the next frame starts.
+ * Every frame is a list of runs that ends with 0x00:
+ *   0x01-0x7F  leave that many LEDs as they are
+ *   0x80-0xBF  (op & 0x3F) + 1 LEDs, each followed by its palette index
+ *   0xC0-0xFF  (op & 0x3F) + 1 LEDs, all set to the one palette index that follows
+ * LEDs after the last run stay as they are.
+ */
+static const uint8_t *lighting_keyframes_decode(const uint8_t *stream, uint8_t *leds) {
+    uint16_t led = 0;
+    for (;;) {
+        uint8_t op = pgm_read_byte(stream++);
+        if (op == 0x00) return stream;
+        if (op < 0x80) {
+            led += op;
+            continue;
+        }
+        uint8_t count = (op & 0x3F) + 1;
+        uint8_t index = op < 0xC0 ? 0 : pgm_read_byte(stream++);
+        for (; count > 0; count--, led++) {
+            if (op < 0xC0) index = pgm_read_byte(stream++);
+            // an animation drawn for a bigger board just loses the LEDs this one does not have
+            if (led < DRIVER_LED_TOTAL) leds[led] = index;
+        }
+    }
+}
+
+void lighting_keyframes_play(lighting_keyframes_state_t *state, const lighting_keyframes_t *keyframes, bool init, uint32_t timer, uint8_t speed) {
+    if (init) {
+        state->frame = 0;
+        state->time  = 0;
+        state->next  = lighting_keyframes_decode(keyframes->stream, state->leds);
+    } else {
+        state->time += (timer - state->timer) * (speed + 1);
+    }
+    state->timer = timer;
+
+    uint32_t frame_time = (uint32_t)keyframes->frame_ms * 128;
+    // A whole loop ends on the frame it started from, so only what is left over has to be decoded
+    uint16_t behind = state->time / frame_time % keyframes->frames;
+    state->time %= frame_time;
+    for (; behind > 0; behind--) {
+        // frame 0 sets every LED, so looping is just starting over
+        if (++state->frame == keyframes->frames) {
+            state->frame = 0;
+            state->next  = keyframes->stream;
+        }
+        state->next = lighting_keyframes_decode(state->next, state->leds);
+    }
+}
@@ -0,0 +1,62 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lighting_types.h"
+#include "random.h"
+
+/* The parts of LED Matrix and RGB Matrix that do not care what a pixel is.
+ * Both build their task, hit tracking and effect runners on top of these,
+ * so they only differ in how a pixel is stored and sent to the driver.
+ */
+
+// The slice of LEDs the current task run renders, when a frame is split over limit LEDs per run.
+// The end is worked out in 16 bits, min + limit passes 255 on boards with more than 128 LEDs.
+#define LIGHTING_USE_LIMITS(min, max, limit) \
+    uint8_t min = (limit)*params->iter;      \
+    uint8_t max = ((uint16_t)min + (limit) > DRIVER_LED_TOTAL) ? DRIVER_LED_TOTAL : min + (limit);
+
+#define LIGHTING_TEST_LED_FLAGS() \
+    if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+
+extern led_config_t g_led_config;
+
+// Appends the LEDs of the key at row, column to the count the keyboard mapped already, and returns the total
+uint8_t lighting_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i, uint8_t led_count);
+
+void lighting_hits_init(last_hit_t *hits);
+// Remembers a hit on each of the LEDs, dropping the oldest ones when there is no room left
+void lighting_hits_record(last_hit_t *hits, const uint8_t *leds, uint8_t count, uint16_t tick);
+// Ages every hit by elapsed ms, forgetting the ones that would run past UINT16_MAX
+void lighting_hits_age(last_hit_t *hits, uint32_t elapsed);
+
+// Adds elapsed ms to a timeout timer, stopping at UINT32_MAX
+void lighting_timer_add(uint32_t *timer, uint32_t elapsed);
+
+// Where a keyframe animation is, the palette index of every LED is the only part of it kept in RAM
+typedef struct {
+    uint8_t        leds[DRIVER_LED_TOTAL];
+    const uint8_t *next;   // where the frame after the one shown starts in the stream
+    uint16_t       frame;  // frame being shown
+    uint32_t       time;   // time spent on it so far, in 1/128 ms at speed 127
+    uint32_t       timer;  // timer the time was last brought up to
+} lighting_keyframes_state_t;
+
+// Brings state->leds up to the frame due at timer, or back to the first one on init
+void lighting_keyframes_play(lighting_keyframes_state_t *state, const lighting_keyframes_t *keyframes, bool init, uint32_t timer, uint8_t speed);
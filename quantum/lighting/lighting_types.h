@@ -0,0 +1,92 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__GNUC__)
+#    define PACKED __attribute__((__packed__))
+#else
+#    define PACKED
+#endif
+
+#if defined(_MSC_VER)
+#    pragma pack(push, 1)
+#endif
+
+// Last led hit
+#ifndef LED_HITS_TO_REMEMBER
+#    define LED_HITS_TO_REMEMBER 8
+#endif  // LED_HITS_TO_REMEMBER
+
+typedef struct PACKED {
+    uint8_t  count;
+    uint8_t  x[LED_HITS_TO_REMEMBER];
+    uint8_t  y[LED_HITS_TO_REMEMBER];
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+} last_hit_t;
+
+typedef enum lighting_task_states { STARTING, RENDERING, FLUSHING, SYNCING } lighting_task_states;
+
+typedef uint8_t led_flags_t;
+
+typedef struct PACKED {
+    uint8_t     iter;
+    led_flags_t flags;
+    bool        init;
+} effect_params_t;
+
+typedef struct PACKED {
+    uint8_t x;
+    uint8_t y;
+} led_point_t;
+
+#define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
+#define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
+
+#define LED_FLAG_ALL 0xFF
+#define LED_FLAG_NONE 0x00
+#define LED_FLAG_MODIFIER 0x01
+#define LED_FLAG_UNDERGLOW 0x02
+#define LED_FLAG_KEYLIGHT 0x04
+#define LED_FLAG_INDICATOR 0x08
+
+#define NO_LED 255
+
+typedef struct PACKED {
+    uint8_t     matrix_co[MATRIX_ROWS][MATRIX_COLS];
+    led_point_t point[DRIVER_LED_TOTAL];
+    uint8_t     flags[DRIVER_LED_TOTAL];
+} led_config_t;
+
+/* A precompiled animation, as written by `qmk generate-keyframes`. The stream holds
+ * the first frame in full and then only what changed in each of the following ones,
+ * every LED is an index into the palette.
+ */
+typedef struct {
+    const uint8_t *palette;
+    const uint8_t *stream;
+    uint16_t       frames;
+    uint16_t       frame_ms;
+    uint8_t        led_count;
+} lighting_keyframes_t;
+
+#if defined(_MSC_VER)
+#    pragma pack(pop)
+#endif
@@ -0,0 +1,44 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "random.h"
+
+// xorshift32 never leaves a state of 0, so that one is swapped for this
+#define RANDOM_XORSHIFT_SEED 0x2545F491UL
+
+void random_xorshift_fill(uint32_t *state, void *data, size_t size) {
+    uint8_t *bytes = data;
+    uint32_t x     = *state ? *state : RANDOM_XORSHIFT_SEED;
+    while (size > 0) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        size_t count = size < sizeof(x) ? size : sizeof(x);
+        memcpy(bytes, &x, count);
+        bytes += count;
+        size -= count;
+    }
+    *state = x;
+}
+
+void random_init(void) { random_driver_init(); }
+
+void random_fill(void *data, size_t size) { random_driver_fill(data, size); }
+
+__attribute__((weak)) void random_driver_add_entropy(uint32_t value) { (void)value; }
+
+void random_add_entropy(uint32_t value) { random_driver_add_entropy(value); }
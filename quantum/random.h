@@ -0,0 +1,54 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Initialize the random driver.
+ */
+void random_init(void);
+
+/**
+ * Fill a buffer with random bytes.
+ *
+ * Fetching everything a frame needs in one call lets a hardware source
+ * be read back to back instead of once per LED.
+ *
+ * \param[out] data  Pointer to a buffer of \a size bytes.
+ * \param[in]  size  Number of bytes to fill.
+ */
+void random_fill(void *data, size_t size);
+
+/**
+ * Mix an unpredictable value, such as the time of a key press, into the random driver.
+ *
+ * Drivers without a hardware entropy source use it so they don't repeat the
+ * same sequence on every boot, the others ignore it.
+ */
+void random_add_entropy(uint32_t value);
+
+/**
+ * Fill a buffer from a xorshift32 generator, advancing \a state.
+ */
+void random_xorshift_fill(uint32_t *state, void *data, size_t size);
+
+/* Implemented by the selected RANDOM_DRIVER */
+void random_driver_init(void);
+void random_driver_fill(void *data, size_t size);
+void random_driver_add_entropy(uint32_t value);
@@ -0,0 +1,59 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef RGB_CURRENT_BUDGET_MA
+
+// Current drawn by one channel at full brightness, in mA
+#    ifndef RGB_CURRENT_RED_MA
+#        define RGB_CURRENT_RED_MA 20
+#    endif
+#    ifndef RGB_CURRENT_GREEN_MA
+#        define RGB_CURRENT_GREEN_MA 20
+#    endif
+#    ifndef RGB_CURRENT_BLUE_MA
+#        define RGB_CURRENT_BLUE_MA 20
+#    endif
+
+// Current drawn by one LED when it is dark, in mA
+#    ifndef RGB_CURRENT_IDLE_MA
+#        define RGB_CURRENT_IDLE_MA 1
+#    endif
+
+#    if RGB_CURRENT_RED_MA + RGB_CURRENT_GREEN_MA + RGB_CURRENT_BLUE_MA > 257
+#        error "The current of one LED at full white must be at most 257mA"
+#    endif
+#    if RGB_CURRENT_BUDGET_MA > 65535
+#        error "RGB_CURRENT_BUDGET_MA must be at most 65535"
+#    endif
+
+// Estimated current of one LED, in 1/255 mA
+static inline uint16_t rgb_current_of(uint8_t red, uint8_t green, uint8_t blue) { return red * RGB_CURRENT_RED_MA + green * RGB_CURRENT_GREEN_MA + blue * RGB_CURRENT_BLUE_MA; }
+
+/* Returns the factor, out of 256, that brings a frame of leds LEDs drawing total (in 1/255 mA)
+ * back within RGB_CURRENT_BUDGET_MA, or 256 when it already fits.
+ */
+static inline uint16_t rgb_current_scale(uint32_t total, uint16_t leds) {
+    int32_t available = (int32_t)RGB_CURRENT_BUDGET_MA - (int32_t)leds * RGB_CURRENT_IDLE_MA;
+    if (available <= 0) return 0;
+    if (total <= (uint32_t)available * 255) return 256;
+    return (uint32_t)available * 255 * 256 / total;
+}
+
+#endif  // RGB_CURRENT_BUDGET_MA
@@ -2,9 +2,9 @@
 RGB_MATRIX_EFFECT(JELLYBEAN_RAINDROPS)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
-static void jellybean_raindrops_set_color(int i, effect_params_t* params) {
+static void jellybean_raindrops_set_color(int i, const uint8_t roll[2], effect_params_t* params) {
     if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) return;
-    HSV hsv = {rand() & 0xFF, qadd8(rand() & 0x7F, 0x80), rgb_matrix_config.hsv.v};
+    HSV hsv = {roll[0], qadd8(roll[1] & 0x7F, 0x80), rgb_matrix_config.hsv.v};
     RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
     rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
 }
@@ -13,14 +13,24 @@ bool JELLYBEAN_RAINDROPS(effect_params_t* params) {
     if (!params->init) {
         // Change one LED every tick, make sure speed is not 0
         if (scale16by8(g_rgb_timer, qadd8(rgb_matrix_config.speed, 16)) % 5 == 0) {
-            jellybean_raindrops_set_color(rand() % DRIVER_LED_TOTAL, params);
+            // Which LED, then its hue and saturation
+            uint8_t rolls[4];
+            rgb_matrix_random_fill(rolls, sizeof(rolls));
+            jellybean_raindrops_set_color(((rolls[0] << 8) | rolls[1]) % DRIVER_LED_TOTAL, &rolls[2], params);
         }
         return false;
     }
 
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    // Rolled a few LEDs at a time, so the stack does not grow with the board
+    uint8_t rolls[8][2];
     for (int i = led_min; i < led_max; i++) {
-        jellybean_raindrops_set_color(i, params);
+        uint8_t roll = (i - led_min) % 8;
+        if (roll == 0) {
+            uint8_t left = led_max - i;
+            rgb_matrix_random_fill(rolls, (left < 8 ? left : 8) * sizeof(rolls[0]));
+        }
+        jellybean_raindrops_set_color(i, rolls[roll], params);
     }
     return led_max < DRIVER_LED_TOTAL;
 }
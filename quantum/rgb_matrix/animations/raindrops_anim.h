@@ -2,7 +2,7 @@
 RGB_MATRIX_EFFECT(RAINDROPS)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
-static void raindrops_set_color(int i, effect_params_t* params) {
+static void raindrops_set_color(int i, uint8_t roll, effect_params_t* params) {
     if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) return;
     HSV hsv = {0, rgb_matrix_config.hsv.s, rgb_matrix_config.hsv.v};
 
@@ -14,7 +14,7 @@ static void raindrops_set_color(int i, effect_params_t* params) {
         deltaH += 256;
     }
 
-    hsv.h   = rgb_matrix_config.hsv.h + (deltaH * (rand() & 0x03));
+    hsv.h   = rgb_matrix_config.hsv.h + (deltaH * (roll & 0x03));
     RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
     rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
 }
@@ -23,14 +23,24 @@ bool RAINDROPS(effect_params_t* params) {
     if (!params->init) {
         // Change one LED every tick, make sure speed is not 0
         if (scale16by8(g_rgb_timer, qadd8(rgb_matrix_config.speed, 16)) % 10 == 0) {
-            raindrops_set_color(rand() % DRIVER_LED_TOTAL, params);
+            // Which LED, then its hue
+            uint8_t rolls[3];
+            rgb_matrix_random_fill(rolls, sizeof(rolls));
+            raindrops_set_color(((rolls[0] << 8) | rolls[1]) % DRIVER_LED_TOTAL, rolls[2], params);
         }
         return false;
     }
 
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    // Rolled a few LEDs at a time, so the stack does not grow with the board
+    uint8_t rolls[16];
     for (int i = led_min; i < led_max; i++) {
-        raindrops_set_color(i, params);
+        uint8_t roll = (i - led_min) % sizeof(rolls);
+        if (roll == 0) {
+            uint8_t left = led_max - i;
+            rgb_matrix_random_fill(rolls, left < sizeof(rolls) ? left : sizeof(rolls));
+        }
+        raindrops_set_color(i, rolls[roll], params);
     }
     return led_max < DRIVER_LED_TOTAL;
 }
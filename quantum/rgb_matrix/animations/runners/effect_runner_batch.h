@@ -0,0 +1,38 @@
+#pragma once
+
+// Number of LEDs a runner collects before converting them to RGB in one go
+#ifndef RGB_MATRIX_HSV_BATCH_SIZE
+#    define RGB_MATRIX_HSV_BATCH_SIZE 16
+#endif  // RGB_MATRIX_HSV_BATCH_SIZE
+
+typedef struct {
+    uint8_t count;
+    uint8_t led[RGB_MATRIX_HSV_BATCH_SIZE];
+    HSV     hsv[RGB_MATRIX_HSV_BATCH_SIZE];
+} effect_batch_t;
+
+static void effect_batch_flush(effect_batch_t* batch) {
+#ifdef RGB_MATRIX_DITHER
+    // keep the fraction for dithering
+    RGB16 rgb[RGB_MATRIX_HSV_BATCH_SIZE];
+    hsv_to_rgb16_batch(batch->hsv, rgb, batch->count);
+    for (uint8_t j = 0; j < batch->count; j++) {
+        rgb_matrix_set_color16(batch->led[j], rgb[j]);
+    }
+#else
+    RGB rgb[RGB_MATRIX_HSV_BATCH_SIZE];
+    rgb_matrix_hsv_to_rgb_batch(batch->hsv, rgb, batch->count);
+    for (uint8_t j = 0; j < batch->count; j++) {
+        rgb_matrix_set_color(batch->led[j], rgb[j].r, rgb[j].g, rgb[j].b);
+    }
+#endif
+    batch->count = 0;
+}
+
+static inline void effect_batch_add(effect_batch_t* batch, uint8_t led, HSV hsv) {
+    batch->led[batch->count] = led;
+    batch->hsv[batch->count] = hsv;
+    if (++batch->count == RGB_MATRIX_HSV_BATCH_SIZE) {
+        effect_batch_flush(batch);
+    }
+}
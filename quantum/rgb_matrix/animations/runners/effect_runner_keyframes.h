@@ -0,0 +1,22 @@
+#pragma once
+
+static lighting_keyframes_state_t keyframes_state;
+
+bool effect_runner_keyframes(effect_params_t* params, const rgb_matrix_keyframes_t* keyframes) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    // The frame only moves on before the first slice, so every slice of a frame draws the same one
+    if (params->iter == 0) lighting_keyframes_play(&keyframes_state, keyframes, params->init, g_rgb_timer, rgb_matrix_config.speed);
+
+    uint8_t brightness = rgb_matrix_config.hsv.v;
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        if (i >= keyframes->led_count) {
+            rgb_matrix_set_color(i, 0, 0, 0);
+            continue;
+        }
+        const uint8_t* color = keyframes->palette + keyframes_state.leds[i] * 3;
+        rgb_matrix_set_color(i, scale8(pgm_read_byte(color), brightness), scale8(pgm_read_byte(color + 1), brightness), scale8(pgm_read_byte(color + 2), brightness));
+    }
+    return led_max < DRIVER_LED_TOTAL;
+}
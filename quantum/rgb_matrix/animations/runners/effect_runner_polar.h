@@ -0,0 +1,22 @@
+#pragma once
+
+typedef HSV (*polar_f)(HSV hsv, uint8_t angle, uint8_t dist, uint8_t time);
+
+bool effect_runner_polar(effect_params_t* params, polar_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint8_t        time  = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+    effect_batch_t batch = {.count = 0};
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+#ifdef RGB_MATRIX_POLAR_TABLE
+        effect_batch_add(&batch, i, effect_func(rgb_matrix_config.hsv, g_led_polar[i].angle, g_led_polar[i].dist, time));
+#else
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        effect_batch_add(&batch, i, effect_func(rgb_matrix_config.hsv, atan2_8(dy, dx), sqrt16(dx * dx + dy * dy), time));
+#endif
+    }
+    effect_batch_flush(&batch);
+    return led_max < DRIVER_LED_TOTAL;
+}
@@ -4,26 +4,41 @@
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+// Returns the largest distance from a hit the effect still changes at this tick, or a negative value if it changes nothing
+typedef int16_t (*reactive_splash_reach_f)(uint16_t tick);
+
+bool effect_runner_reactive_splash_bounded(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    // Everything that only depends on the hit is worked out once per frame instead of once per LED
+    uint8_t  count = g_last_hit_tracker.count;
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+    int16_t  reach[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        tick[j]  = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        reach[j] = reach_func ? reach_func(tick[j]) : INT16_MAX;
+    }
+
+    effect_batch_t batch = {.count = 0};
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         HSV hsv = rgb_matrix_config.hsv;
         hsv.v   = 0;
         for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+            // The distance is at least the larger of |dx| and |dy|, so LEDs outside the box around the reach are skipped without a sqrt16
+            if (dx > reach[j] || -dx > reach[j] || dy > reach[j] || -dy > reach[j]) continue;
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            hsv          = effect_func(hsv, dx, dy, dist, tick[j]);
         }
-        hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
-        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        effect_batch_add(&batch, i, hsv);
     }
+    effect_batch_flush(&batch);
     return led_max < DRIVER_LED_TOTAL;
 }
 
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) { return effect_runner_reactive_splash_bounded(start, params, effect_func, NULL); }
+
 #endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
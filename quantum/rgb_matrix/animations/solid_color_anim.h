@@ -4,10 +4,10 @@ RGB_MATRIX_EFFECT(SOLID_COLOR)
 bool SOLID_COLOR(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    RGB rgb = rgb_matrix_hsv_to_rgb(rgb_matrix_config.hsv);
+    RGB16 rgb = rgb_matrix_hsv_to_rgb16(rgb_matrix_config.hsv);
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        rgb_matrix_set_color16(i, rgb);
     }
     return led_max < DRIVER_LED_TOTAL;
 }
@@ -6,80 +6,102 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #            define RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS 25
 #        endif
 
+#        if MATRIX_ROWS * MATRIX_COLS > 255
+typedef uint16_t heatmap_cell_t;
+#        else
+typedef uint8_t heatmap_cell_t;
+#        endif
+
+// The warm cells, as row * MATRIX_COLS + col, in no particular order. Only these are ever looked at.
+static heatmap_cell_t heatmap_cells[MATRIX_ROWS * MATRIX_COLS];
+static heatmap_cell_t heatmap_cell_count = 0;
+// The decay tick of the last frame, every warm cell still had some heat left at it.
+static uint32_t heatmap_tick;
+
+/* A warm cell keeps, in g_rgb_frame_buffer, the decay tick its heat runs out at, so it cools
+ * down without being touched. One decay tick is RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS.
+ */
+static inline uint8_t *heatmap_expiry(heatmap_cell_t cell) { return &g_rgb_frame_buffer[0][0] + cell; }
+
+static void heatmap_add(uint8_t row, uint8_t col, uint8_t amount) {
+    heatmap_cell_t cell = row * MATRIX_COLS + col;
+    uint8_t        heat = 0;
+    heatmap_cell_t i;
+    for (i = 0; i < heatmap_cell_count; i++) {
+        if (heatmap_cells[i] == cell) {
+            heat = *heatmap_expiry(cell) - (uint8_t)heatmap_tick;
+            break;
+        }
+    }
+    if (i == heatmap_cell_count) heatmap_cells[heatmap_cell_count++] = cell;
+    *heatmap_expiry(cell) = (uint8_t)heatmap_tick + qadd8(heat, amount);
+}
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
     uint8_t m_row = row - 1;
     uint8_t p_row = row + 1;
     uint8_t m_col = col - 1;
     uint8_t p_col = col + 1;
 
-    if (m_col < col) g_rgb_frame_buffer[row][m_col] = qadd8(g_rgb_frame_buffer[row][m_col], 16);
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
-    if (p_col < MATRIX_COLS) g_rgb_frame_buffer[row][p_col] = qadd8(g_rgb_frame_buffer[row][p_col], 16);
+    if (m_col < col) heatmap_add(row, m_col, 16);
+    heatmap_add(row, col, 32);
+    if (p_col < MATRIX_COLS) heatmap_add(row, p_col, 16);
 
     if (p_row < MATRIX_ROWS) {
-        if (m_col < col) g_rgb_frame_buffer[p_row][m_col] = qadd8(g_rgb_frame_buffer[p_row][m_col], 13);
-        g_rgb_frame_buffer[p_row][col] = qadd8(g_rgb_frame_buffer[p_row][col], 16);
-        if (p_col < MATRIX_COLS) g_rgb_frame_buffer[p_row][p_col] = qadd8(g_rgb_frame_buffer[p_row][p_col], 13);
+        if (m_col < col) heatmap_add(p_row, m_col, 13);
+        heatmap_add(p_row, col, 16);
+        if (p_col < MATRIX_COLS) heatmap_add(p_row, p_col, 13);
     }
 
     if (m_row < row) {
-        if (m_col < col) g_rgb_frame_buffer[m_row][m_col] = qadd8(g_rgb_frame_buffer[m_row][m_col], 13);
-        g_rgb_frame_buffer[m_row][col] = qadd8(g_rgb_frame_buffer[m_row][col], 16);
-        if (p_col < MATRIX_COLS) g_rgb_frame_buffer[m_row][p_col] = qadd8(g_rgb_frame_buffer[m_row][p_col], 13);
+        if (m_col < col) heatmap_add(m_row, m_col, 13);
+        heatmap_add(m_row, col, 16);
+        if (p_col < MATRIX_COLS) heatmap_add(m_row, p_col, 13);
     }
 }
 
-// A timer to track the last time we decremented all heatmap values.
-static uint16_t heatmap_decrease_timer;
-// Whether we should decrement the heatmap values during the next update.
-static bool decrease_heatmap_values;
-
 bool TYPING_HEATMAP(effect_params_t* params) {
-    // Modified version of RGB_MATRIX_USE_LIMITS to work off of matrix row / col size
-    uint8_t led_min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter;
-    uint8_t led_max = led_min + RGB_MATRIX_LED_PROCESS_LIMIT;
-    if (led_max > sizeof(g_rgb_frame_buffer)) led_max = sizeof(g_rgb_frame_buffer);
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
-        memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+        heatmap_cell_count = 0;
+        heatmap_tick       = g_rgb_timer / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
     }
 
-    // The heatmap animation might run in several iterations depending on
-    // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
-    // timer when the animation starts.
-    if (params->iter == 0) {
-        decrease_heatmap_values = timer_elapsed(heatmap_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
-
-        // Restart the timer if we are going to decrease the heatmap this frame.
-        if (decrease_heatmap_values) {
-            heatmap_decrease_timer = timer_read();
-        }
+    // Cold LEDs only need to be dark, the warm ones are drawn over them once every LED has been through here
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        rgb_matrix_set_color(i, 0, 0, 0);
     }
+    if (led_max < DRIVER_LED_TOTAL) return true;
+
+    uint32_t tick    = g_rgb_timer / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+    uint32_t elapsed = tick - heatmap_tick;
+    for (heatmap_cell_t i = 0; i < heatmap_cell_count;) {
+        heatmap_cell_t cell = heatmap_cells[i];
+        // What was left at the last frame is always 1 to 255, so it can't be mistaken after the 8-bit tick wraps
+        uint8_t left = *heatmap_expiry(cell) - (uint8_t)heatmap_tick;
+        if (elapsed >= left) {
+            // Gone cold, drop it so it costs nothing from now on
+            heatmap_cells[i] = heatmap_cells[--heatmap_cell_count];
+            continue;
+        }
+        uint8_t val = left - elapsed;
+        HSV     hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+        RGB     rgb = rgb_matrix_hsv_to_rgb(hsv);
 
-    // Render heatmap & decrease
-    for (int i = led_min; i < led_max; i++) {
-        uint8_t row = i % MATRIX_ROWS;
-        uint8_t col = i / MATRIX_ROWS;
-        uint8_t val = g_rgb_frame_buffer[row][col];
-
-        // set the pixel colour
         uint8_t led[LED_HITS_TO_REMEMBER];
-        uint8_t led_count = rgb_matrix_map_row_column_to_led(row, col, led);
+        uint8_t led_count = rgb_matrix_map_row_column_to_led(cell / MATRIX_COLS, cell % MATRIX_COLS, led);
         for (uint8_t j = 0; j < led_count; ++j) {
             if (!HAS_ANY_FLAGS(g_led_config.flags[led[j]], params->flags)) continue;
-
-            HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
-            RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
             rgb_matrix_set_color(led[j], rgb.r, rgb.g, rgb.b);
         }
-
-        if (decrease_heatmap_values) {
-            g_rgb_frame_buffer[row][col] = qsub8(val, 1);
-        }
+        i++;
     }
+    heatmap_tick = tick;
 
-    return led_max < sizeof(g_rgb_frame_buffer);
+    return false;
 }
 
 #    endif  // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
@@ -20,7 +20,10 @@
 #include "progmem.h"
 #include "config.h"
 #include "eeprom.h"
+#include "led_tables.h"
+#include "rgb_current.h"
 #include <string.h>
+#include <stdlib.h>
 #include <math.h>
 
 #include <lib/lib8tion/lib8tion.h>
@@ -41,6 +44,22 @@ const led_point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 
 __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) { return hsv_to_rgb(hsv); }
 
+// Goes through rgb_matrix_hsv_to_rgb(), so overriding that one still covers the effect runners
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = rgb_matrix_hsv_to_rgb(hsv[i]);
+    }
+}
+
+RGB16 rgb_matrix_hsv_to_rgb16(HSV hsv) {
+#ifdef RGB_MATRIX_DITHER
+    return hsv_to_rgb16(hsv);
+#else
+    RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+    return (RGB16){.r = rgb.r << 8, .g = rgb.g << 8, .b = rgb.b << 8};
+#endif
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -125,6 +144,9 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_POLAR_TABLE
+led_polar_t g_led_polar[DRIVER_LED_TOTAL];
+#endif  // RGB_MATRIX_POLAR_TABLE
 
 // internals
 static bool            suspend_state     = false;
@@ -148,6 +170,136 @@ static last_hit_t last_hit_buffer;
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
 #endif
 
+#ifdef RGB_MATRIX_GOVERNOR
+// Longest a single render run may take on average
+#    ifndef RGB_MATRIX_GOVERNOR_TASK_BUDGET_US
+#        define RGB_MATRIX_GOVERNOR_TASK_BUDGET_US 500
+#    endif
+// Frame rate to aim for when there is time to spare
+#    ifndef RGB_MATRIX_GOVERNOR_TARGET_FPS
+#        define RGB_MATRIX_GOVERNOR_TARGET_FPS 60
+#    endif
+// Share of the time, in percent, rendering and flushing may use
+#    ifndef RGB_MATRIX_GOVERNOR_MAX_LOAD
+#        define RGB_MATRIX_GOVERNOR_MAX_LOAD 25
+#    endif
+// Slowest frame interval the governor falls back to
+#    ifndef RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS
+#        define RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS 100
+#    endif
+
+#    if RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+uint8_t g_rgb_process_limit = RGB_MATRIX_LED_PROCESS_LIMIT;
+#    else
+uint8_t g_rgb_process_limit = DRIVER_LED_TOTAL;
+#    endif
+static uint16_t rgb_flush_limit = RGB_MATRIX_LED_FLUSH_LIMIT;
+
+// The timer only counts milliseconds, so every task run adds its elapsed time, 0 or 1 for the
+// short ones. Summed over a frame this averages out to the real cost.
+static uint16_t governor_render_ms    = 0;
+static uint16_t governor_render_calls = 0;
+static uint16_t governor_frame_ms     = 0;
+static uint16_t governor_task_us      = 0;
+
+static void rgb_matrix_governor_update(void) {
+    if (governor_render_calls > 0) {
+        uint32_t task_us = (uint32_t)governor_render_ms * 1000 / governor_render_calls;
+        governor_task_us = ((uint32_t)governor_task_us * 3 + task_us) / 4;
+    }
+
+    // Fewer LEDs per run when a run takes too long, creep back up once there is room
+    if (governor_task_us > RGB_MATRIX_GOVERNOR_TASK_BUDGET_US && g_rgb_process_limit > 1) {
+        g_rgb_process_limit -= (g_rgb_process_limit + 3) / 4;
+    } else if (governor_task_us < RGB_MATRIX_GOVERNOR_TASK_BUDGET_US / 2 && g_rgb_process_limit < DRIVER_LED_TOTAL) {
+        g_rgb_process_limit++;
+    }
+
+    // Space the frames so lighting stays within its share of the time
+    uint32_t interval = (uint32_t)governor_frame_ms * 100 / RGB_MATRIX_GOVERNOR_MAX_LOAD;
+    if (interval < 1000 / RGB_MATRIX_GOVERNOR_TARGET_FPS) interval = 1000 / RGB_MATRIX_GOVERNOR_TARGET_FPS;
+    if (interval > RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS) interval = RGB_MATRIX_GOVERNOR_MAX_FLUSH_MS;
+    rgb_flush_limit = ((uint32_t)rgb_flush_limit * 3 + interval) / 4;
+
+    governor_render_ms    = 0;
+    governor_render_calls = 0;
+    governor_frame_ms     = 0;
+}
+#    define RGB_MATRIX_FLUSH_INTERVAL rgb_flush_limit
+#else
+#    define RGB_MATRIX_FLUSH_INTERVAL RGB_MATRIX_LED_FLUSH_LIMIT
+#endif  // RGB_MATRIX_GOVERNOR
+
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+#    ifndef PROTOCOL_CHIBIOS
+#        error "RGB_MATRIX_ASYNC_FLUSH is only supported on ChibiOS"
+#    endif
+#    include <ch.h>
+#    include <hal.h>
+
+// The flush thread shares the bus with anything the main loop talks to, such as an OLED or the split transport
+#    if HAL_USE_I2C && !I2C_USE_MUTUAL_EXCLUSION
+#        error "RGB_MATRIX_ASYNC_FLUSH requires I2C_USE_MUTUAL_EXCLUSION to be TRUE in halconf.h"
+#    endif
+#    if HAL_USE_SPI && !SPI_USE_MUTUAL_EXCLUSION
+#        error "RGB_MATRIX_ASYNC_FLUSH requires SPI_USE_MUTUAL_EXCLUSION to be TRUE in halconf.h"
+#    endif
+
+#    ifndef RGB_MATRIX_ASYNC_FLUSH_PRIORITY
+#        define RGB_MATRIX_ASYNC_FLUSH_PRIORITY (NORMALPRIO + 1)
+#    endif
+
+// The flush thread runs the whole driver flush, down to the I2C or SPI transfer
+#    ifndef RGB_MATRIX_ASYNC_FLUSH_STACK_SIZE
+#        define RGB_MATRIX_ASYNC_FLUSH_STACK_SIZE 512
+#    endif
+
+// Effects render into the back buffer while the flush thread sends the front buffer to the driver
+static RGB                rgb_back_buffer[DRIVER_LED_TOTAL];
+static RGB                rgb_front_buffer[DRIVER_LED_TOTAL];
+static binary_semaphore_t rgb_flush_request;
+static binary_semaphore_t rgb_flush_idle;
+
+static THD_WORKING_AREA(waRgbFlushThread, RGB_MATRIX_ASYNC_FLUSH_STACK_SIZE);
+static THD_FUNCTION(RgbFlushThread, arg) {
+    (void)arg;
+    chRegSetThreadName("rgb_flush");
+    while (true) {
+        chBSemWait(&rgb_flush_request);
+        for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+            rgb_matrix_driver.set_color(i, rgb_front_buffer[i].r, rgb_front_buffer[i].g, rgb_front_buffer[i].b);
+        }
+        // Waiting on the bus here only blocks this thread, the main loop keeps scanning and rendering
+        rgb_matrix_driver.flush();
+        chBSemSignal(&rgb_flush_idle);
+    }
+}
+
+static void rgb_matrix_flush_start(void) {
+    memcpy(rgb_front_buffer, rgb_back_buffer, sizeof(rgb_front_buffer));
+    chBSemSignal(&rgb_flush_request);
+}
+#endif  // RGB_MATRIX_ASYNC_FLUSH
+
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+#    if !defined(RGB_MATRIX_SPLIT) || defined(DISABLE_SYNC_TIMER)
+#        error "RGB_MATRIX_SPLIT_LOCKSTEP requires RGB_MATRIX_SPLIT and the sync timer"
+#    endif
+#    ifndef RANDOM_ENABLE
+#        error "RGB_MATRIX_SPLIT_LOCKSTEP requires RANDOM_ENABLE = yes in rules.mk, the master draws the shared seed from the random driver"
+#    endif
+_Static_assert((RGB_MATRIX_LOCKSTEP_EVENTS & (RGB_MATRIX_LOCKSTEP_EVENTS - 1)) == 0, "RGB_MATRIX_LOCKSTEP_EVENTS must be a power of two");
+
+// master: published for the slave, slave: last received from the master
+static rgb_lockstep_frame_t  lockstep_frame;
+static rgb_lockstep_events_t lockstep_events;
+static uint8_t               lockstep_events_applied = 0;
+static bool                  lockstep_frame_pending  = false;
+static bool                  lockstep_frame_received = false;
+// Only the effects draw from this, so the random driver stays unpredictable for everything else
+static uint32_t              lockstep_random_state;
+#endif  // RGB_MATRIX_SPLIT_LOCKSTEP
+
 void eeconfig_read_rgb_matrix(void) { eeprom_read_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config)); }
 
 void eeconfig_update_rgb_matrix(void) { eeprom_update_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config)); }
@@ -176,38 +328,164 @@ void eeconfig_debug_rgb_matrix(void) {
 __attribute__((weak)) uint8_t rgb_matrix_map_row_column_to_led_kb(uint8_t row, uint8_t column, uint8_t *led_i) { return 0; }
 
 uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i) {
-    uint8_t led_count = rgb_matrix_map_row_column_to_led_kb(row, column, led_i);
-    uint8_t led_index = g_led_config.matrix_co[row][column];
-    if (led_index != NO_LED) {
-        led_i[led_count] = led_index;
-        led_count++;
+    return lighting_map_row_column_to_led(row, column, led_i, rgb_matrix_map_row_column_to_led_kb(row, column, led_i));
+}
+
+static inline void rgb_matrix_driver_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+    if (index >= 0 && index < DRIVER_LED_TOTAL) {
+        rgb_back_buffer[index].r = red;
+        rgb_back_buffer[index].g = green;
+        rgb_back_buffer[index].b = blue;
+    }
+#else
+    rgb_matrix_driver.set_color(index, red, green, blue);
+#endif
+}
+
+// Number of LEDs driven by this half
+static inline uint8_t rgb_matrix_local_led_count(void) {
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+    return is_keyboard_left() ? k_rgb_matrix_split[0] : k_rgb_matrix_split[1];
+#else
+    return DRIVER_LED_TOTAL;
+#endif
+}
+
+#ifdef RGB_CURRENT_BUDGET_MA
+// Estimated current of the frame as set, in 1/255 mA, every write adjusts it by the difference so it is never summed up again
+static uint32_t rgb_current_total = 0;
+
+#    ifndef RGB_MATRIX_DITHER
+// The colors as set, before any scaling, and whether the driver currently holds a scaled down frame
+static RGB  rgb_current_frame[DRIVER_LED_TOTAL];
+static bool rgb_current_scaled = false;
+
+static inline void rgb_matrix_current_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index < 0 || index >= DRIVER_LED_TOTAL) return;
+    rgb_current_total -= rgb_current_of(rgb_current_frame[index].r, rgb_current_frame[index].g, rgb_current_frame[index].b);
+    rgb_current_total += rgb_current_of(red, green, blue);
+    rgb_current_frame[index].r = red;
+    rgb_current_frame[index].g = green;
+    rgb_current_frame[index].b = blue;
+    rgb_matrix_driver_set_color(index, red, green, blue);
+}
+
+// Rewrites the frame scaled down when it is over the budget, or as set when the last one was scaled and this one fits
+static void rgb_matrix_current_limit(void) {
+    uint8_t  count = rgb_matrix_local_led_count();
+    uint16_t scale = rgb_current_scale(rgb_current_total, count);
+    if (scale == 256 && !rgb_current_scaled) return;
+    for (uint8_t i = 0; i < count; i++) {
+        rgb_matrix_driver_set_color(i, rgb_current_frame[i].r * scale >> 8, rgb_current_frame[i].g * scale >> 8, rgb_current_frame[i].b * scale >> 8);
+    }
+    rgb_current_scaled = scale < 256;
+}
+#    endif
+#endif  // RGB_CURRENT_BUDGET_MA
+
+#ifdef RGB_MATRIX_DITHER
+// The colors as set, in 8.8 fixed point, and the fraction of a step each channel still owes from earlier frames
+static RGB16   rgb_dither_level[DRIVER_LED_TOTAL];
+static uint8_t rgb_dither_error[DRIVER_LED_TOTAL][3];
+
+static void rgb_matrix_dither_init(void) {
+    // Start every LED at a different point of its cycle, so LEDs on the same fractional level don't all step up in the same frame
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        rgb_dither_error[i][0] = i * 157;
+        rgb_dither_error[i][1] = i * 157 + 85;
+        rgb_dither_error[i][2] = i * 157 + 170;
     }
-    return led_count;
 }
 
-void rgb_matrix_update_pwm_buffers(void) { rgb_matrix_driver.flush(); }
+// Sends this frame's 8-bit share of every level to the driver, runs once per flush even when nothing changed
+static void rgb_matrix_dither(void) {
+    uint8_t count = rgb_matrix_local_led_count();
+#    ifdef RGB_CURRENT_BUDGET_MA
+    uint16_t scale = rgb_current_scale(rgb_current_total, count);
+#    endif
+    for (uint8_t i = 0; i < count; i++) {
+        RGB16 level = rgb_dither_level[i];
+#    ifdef RGB_CURRENT_BUDGET_MA
+        if (scale < 256) {
+            level.r = (uint32_t)level.r * scale >> 8;
+            level.g = (uint32_t)level.g * scale >> 8;
+            level.b = (uint32_t)level.b * scale >> 8;
+        }
+#    endif
+        rgb_matrix_driver_set_color(i, dither8(level.r, &rgb_dither_error[i][0]), dither8(level.g, &rgb_dither_error[i][1]), dither8(level.b, &rgb_dither_error[i][2]));
+    }
+}
+#endif  // RGB_MATRIX_DITHER
+
+// Last pass over the frame before it goes out to the driver
+static inline void rgb_matrix_finish_frame(void) {
+#if defined(RGB_MATRIX_DITHER)
+    rgb_matrix_dither();
+#elif defined(RGB_CURRENT_BUDGET_MA)
+    rgb_matrix_current_limit();
+#endif
+}
+
+void rgb_matrix_update_pwm_buffers(void) {
+    rgb_matrix_finish_frame();
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+    chBSemWait(&rgb_flush_idle);
+    rgb_matrix_flush_start();
+#else
+    rgb_matrix_driver.flush();
+#endif
+}
+
+void rgb_matrix_set_color16(int index, RGB16 color) {
+#ifdef RGB_MATRIX_DITHER
+#    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+    if (!is_keyboard_left()) {
+        if (index < k_rgb_matrix_split[0]) return;
+        index -= k_rgb_matrix_split[0];
+    } else if (index >= k_rgb_matrix_split[0]) {
+        return;
+    }
+#    endif
+    if (index < 0 || index >= DRIVER_LED_TOTAL) return;
+#    ifdef RGB_CURRENT_BUDGET_MA
+    rgb_current_total -= rgb_current_of(rgb_dither_level[index].r >> 8, rgb_dither_level[index].g >> 8, rgb_dither_level[index].b >> 8);
+    rgb_current_total += rgb_current_of(color.r >> 8, color.g >> 8, color.b >> 8);
+#    endif
+    rgb_dither_level[index] = color;
+#else
+    rgb_matrix_set_color(index, color.r >> 8, color.g >> 8, color.b >> 8);
+#endif
+}
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#ifdef RGB_MATRIX_DITHER
+    rgb_matrix_set_color16(index, (RGB16){.r = red << 8, .g = green << 8, .b = blue << 8});
+#else
+#    ifdef RGB_CURRENT_BUDGET_MA
+#        define rgb_matrix_local_set_color rgb_matrix_current_set_color
+#    else
+#        define rgb_matrix_local_set_color rgb_matrix_driver_set_color
+#    endif
+#    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     if (!is_keyboard_left() && index >= k_rgb_matrix_split[0])
-        rgb_matrix_driver.set_color(index - k_rgb_matrix_split[0], red, green, blue);
+        rgb_matrix_local_set_color(index - k_rgb_matrix_split[0], red, green, blue);
     else if (is_keyboard_left() && index < k_rgb_matrix_split[0])
+#    endif
+        rgb_matrix_local_set_color(index, red, green, blue);
+#    undef rgb_matrix_local_set_color
 #endif
-        rgb_matrix_driver.set_color(index, red, green, blue);
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#if (defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)) || defined(RGB_MATRIX_ASYNC_FLUSH) || defined(RGB_MATRIX_DITHER) || defined(RGB_CURRENT_BUDGET_MA)
     for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) rgb_matrix_set_color(i, red, green, blue);
 #else
     rgb_matrix_driver.set_color_all(red, green, blue);
 #endif
 }
 
-void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
-#ifndef RGB_MATRIX_SPLIT
-    if (!is_keyboard_master()) return;
-#endif
+static void rgb_matrix_process_event(uint8_t row, uint8_t col, bool pressed, uint16_t tick) {
 #if RGB_DISABLE_TIMEOUT > 0
     rgb_anykey_timer = 0;
 #endif  // RGB_DISABLE_TIMEOUT > 0
@@ -225,22 +503,7 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2);  // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
-    }
+    lighting_hits_record(&last_hit_buffer, led, led_count, tick);
 #endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 #if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
@@ -250,6 +513,68 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #endif  // defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
 }
 
+void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
+#if defined(RGB_MATRIX_SPLIT_LOCKSTEP)
+    // The slave gets every key event, including its own, from the master so both halves track the same hits
+    if (!is_keyboard_master()) return;
+    rgb_lockstep_event_t *event = &lockstep_events.events[lockstep_events.count % RGB_MATRIX_LOCKSTEP_EVENTS];
+    event->row                  = row;
+    event->col                  = col;
+    event->pressed              = pressed;
+    event->time                 = sync_timer_read();
+    lockstep_events.count++;
+#elif !defined(RGB_MATRIX_SPLIT)
+    if (!is_keyboard_master()) return;
+#endif
+    rgb_matrix_process_event(row, col, pressed, 0);
+}
+
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+const rgb_lockstep_frame_t *rgb_matrix_get_lockstep_frame(void) { return &lockstep_frame; }
+
+const rgb_lockstep_events_t *rgb_matrix_get_lockstep_events(void) { return &lockstep_events; }
+
+void rgb_matrix_update_lockstep_frame(const rgb_lockstep_frame_t *frame) {
+    if (memcmp(&lockstep_frame, frame, sizeof(lockstep_frame)) != 0) {
+        lockstep_frame          = *frame;
+        lockstep_frame_pending  = true;
+        lockstep_frame_received = true;
+    }
+}
+
+void rgb_matrix_update_lockstep_events(const rgb_lockstep_events_t *events) {
+    if (!lockstep_frame_received) {
+        // The master sends its events ahead of its first frame, anything counted before that happened before this half was listening
+        lockstep_events_applied = events->count;
+        return;
+    }
+    uint8_t pending = events->count - lockstep_events_applied;
+    if (pending > RGB_MATRIX_LOCKSTEP_EVENTS) {
+        // Anything older has already been overwritten on the master
+        pending = RGB_MATRIX_LOCKSTEP_EVENTS;
+    }
+    for (; pending > 0; pending--) {
+        const rgb_lockstep_event_t *event = &events->events[(uint8_t)(events->count - pending) % RGB_MATRIX_LOCKSTEP_EVENTS];
+        rgb_matrix_process_event(event->row, event->col, event->pressed, sync_timer_elapsed(event->time));
+    }
+    lockstep_events_applied = events->count;
+}
+#endif  // RGB_MATRIX_SPLIT_LOCKSTEP
+
+void rgb_matrix_random_fill(void *data, size_t size) {
+#if defined(RGB_MATRIX_SPLIT_LOCKSTEP)
+    random_xorshift_fill(&lockstep_random_state, data, size);
+#elif defined(RANDOM_ENABLE)
+    random_fill(data, size);
+#else
+    // Without the random driver the effects draw from rand(), as they did before it existed
+    uint8_t *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        bytes[i] = rand();
+    }
+#endif
+}
+
 void rgb_matrix_test(void) {
     // Mask out bits 4 and 5
     // Increase the factor to make the test animation slower (and reduce to make it faster)
@@ -291,25 +616,12 @@ static void rgb_task_timers(void) {
 
     // Update double buffer timers
 #if RGB_DISABLE_TIMEOUT > 0
-    if (rgb_anykey_timer < UINT32_MAX) {
-        if (UINT32_MAX - deltaTime < rgb_anykey_timer) {
-            rgb_anykey_timer = UINT32_MAX;
-        } else {
-            rgb_anykey_timer += deltaTime;
-        }
-    }
+    lighting_timer_add(&rgb_anykey_timer, deltaTime);
 #endif  // RGB_DISABLE_TIMEOUT > 0
 
     // Update double buffer last hit timers
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
-    }
+    lighting_hits_age(&last_hit_buffer, deltaTime);
 #endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
@@ -317,10 +629,22 @@ static void rgb_task_sync(void) {
     // next task
     if (rgb_update_eeprom) eeconfig_update_rgb_matrix();
     rgb_update_eeprom = false;
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    if (!is_keyboard_master()) {
+        // The master paces the frames
+        if (lockstep_frame_pending) rgb_task_state = STARTING;
+        return;
+    }
+#endif  // RGB_MATRIX_SPLIT_LOCKSTEP
+    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_FLUSH_INTERVAL) rgb_task_state = STARTING;
 }
 
 static void rgb_task_start(void) {
+#ifdef RGB_MATRIX_GOVERNOR
+    // tune the limits from what the last frame cost
+    rgb_matrix_governor_update();
+#endif
+
     // reset iter
     rgb_effect_params.iter = 0;
 
@@ -330,6 +654,19 @@ static void rgb_task_start(void) {
     g_last_hit_tracker = last_hit_buffer;
 #endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    // Both halves render each frame from the same timer and random seed, the master draws a fresh seed from the driver every frame
+    if (is_keyboard_master()) {
+        lockstep_frame.timer = g_rgb_timer;
+        random_driver_fill(&lockstep_frame.seed, sizeof(lockstep_frame.seed));
+    } else {
+        g_rgb_timer = lockstep_frame.timer;
+        lockstep_frame_pending = false;
+    }
+    lockstep_random_state = lockstep_frame.seed;
+    random16_set_seed(lockstep_frame.seed);
+#endif  // RGB_MATRIX_SPLIT_LOCKSTEP
+
     // next task
     rgb_task_state = RENDERING;
 }
@@ -395,12 +732,22 @@ static void rgb_task_render(uint8_t effect) {
 }
 
 static void rgb_task_flush(uint8_t effect) {
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+    // Hand the frame to the flush thread, if it is still busy with the last one try again on the next task run
+    if (chBSemWaitTimeout(&rgb_flush_idle, TIME_IMMEDIATE) != MSG_OK) return;
+#endif
+
     // update last trackers after the first full render so we can init over several frames
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
 
     // update pwm buffers
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+    rgb_matrix_finish_frame();
+    rgb_matrix_flush_start();
+#else
     rgb_matrix_update_pwm_buffers();
+#endif
 
     // next task
     rgb_task_state = SYNCING;
@@ -419,6 +766,11 @@ void rgb_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
 
+#ifdef RGB_MATRIX_GOVERNOR
+    rgb_task_states task_state = rgb_task_state;
+    uint16_t        task_start = timer_read();
+#endif
+
     switch (rgb_task_state) {
         case STARTING:
             rgb_task_start();
@@ -437,6 +789,17 @@ void rgb_matrix_task(void) {
             rgb_task_sync();
             break;
     }
+
+#ifdef RGB_MATRIX_GOVERNOR
+    if (task_state == RENDERING || task_state == FLUSHING) {
+        uint16_t task_ms = timer_elapsed(task_start);
+        governor_frame_ms += task_ms;
+        if (task_state == RENDERING) {
+            governor_render_ms += task_ms;
+            governor_render_calls++;
+        }
+    }
+#endif  // RGB_MATRIX_GOVERNOR
 }
 
 void rgb_matrix_indicators(void) {
@@ -454,10 +817,9 @@ void rgb_matrix_indicators_advanced(effect_params_t *params) {
      * and not sure which would be better. Otherwise, this should be called from
      * rgb_task_render, right before the iter++ line.
      */
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
-    uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * (params->iter - 1);
-    uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;
-    if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
+#if defined(RGB_MATRIX_GOVERNOR) || (defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL)
+    uint8_t min = RGB_MATRIX_PROCESS_LIMIT * (params->iter - 1);
+    uint8_t max = ((uint16_t)min + RGB_MATRIX_PROCESS_LIMIT > DRIVER_LED_TOTAL) ? DRIVER_LED_TOTAL : min + RGB_MATRIX_PROCESS_LIMIT;
 #else
     uint8_t min = 0;
     uint8_t max = DRIVER_LED_TOTAL;
@@ -473,16 +835,28 @@ __attribute__((weak)) void rgb_matrix_indicators_advanced_user(uint8_t led_min,
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        g_last_hit_tracker.tick[i] = UINT16_MAX;
+#ifdef RGB_MATRIX_DITHER
+    rgb_matrix_dither_init();
+#endif  // RGB_MATRIX_DITHER
+
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+    chBSemObjectInit(&rgb_flush_request, true);
+    chBSemObjectInit(&rgb_flush_idle, false);
+    chThdCreateStatic(waRgbFlushThread, sizeof(waRgbFlushThread), RGB_MATRIX_ASYNC_FLUSH_PRIORITY, RgbFlushThread, NULL);
+#endif  // RGB_MATRIX_ASYNC_FLUSH
+
+#ifdef RGB_MATRIX_POLAR_TABLE
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        int16_t dx           = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy           = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        g_led_polar[i].angle = atan2_8(dy, dx);
+        g_led_polar[i].dist  = sqrt16(dx * dx + dy * dy);
     }
+#endif  // RGB_MATRIX_POLAR_TABLE
 
-    last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    lighting_hits_init(&g_last_hit_tracker);
+    lighting_hits_init(&last_hit_buffer);
 #endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     if (!eeconfig_is_enabled()) {
@@ -503,7 +877,17 @@ void rgb_matrix_set_suspend_state(bool state) {
 #ifdef RGB_DISABLE_WHEN_USB_SUSPENDED
     if (state && !suspend_state) {  // only run if turning off, and only once
         rgb_task_render(0);         // turn off all LEDs when suspending
-        rgb_task_flush(0);          // and actually flash led state to LEDs
+#    ifdef RGB_MATRIX_ASYNC_FLUSH
+        // let the flush thread finish the last frame, so this one isn't dropped
+        chBSemWait(&rgb_flush_idle);
+        chBSemSignal(&rgb_flush_idle);
+#    endif
+        rgb_task_flush(0);  // and actually flash led state to LEDs
+#    ifdef RGB_MATRIX_ASYNC_FLUSH
+        // and wait until it is sent
+        chBSemWait(&rgb_flush_idle);
+        chBSemSignal(&rgb_flush_idle);
+#    endif
     }
     suspend_state = state;
 #endif
@@ -21,6 +21,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "rgb_matrix_types.h"
+#include "lighting.h"
 #include "color.h"
 #include "quantum.h"
 #include "rgb_matrix_legacy_enables.h"
@@ -37,6 +38,8 @@
 #    include "aw20216.h"
 #elif defined(WS2812)
 #    include "ws2812.h"
+#elif defined(APA102)
+#    include "apa102.h"
 #endif
 
 #ifndef RGB_MATRIX_LED_FLUSH_LIMIT
@@ -47,11 +50,21 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT (DRIVER_LED_TOTAL + 4) / 5
 #endif
 
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
-#    define RGB_MATRIX_USE_LIMITS(min, max)                        \
-        uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter; \
-        uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;          \
-        if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
+// The polar table costs two bytes of RAM per LED, so AVR boards have to opt in
+#if !defined(RGB_MATRIX_POLAR_TABLE) && !defined(__AVR__)
+#    define RGB_MATRIX_POLAR_TABLE
+#endif
+
+// The governor adjusts the number of LEDs processed per task run while running
+#ifdef RGB_MATRIX_GOVERNOR
+extern uint8_t g_rgb_process_limit;
+#    define RGB_MATRIX_PROCESS_LIMIT g_rgb_process_limit
+#else
+#    define RGB_MATRIX_PROCESS_LIMIT RGB_MATRIX_LED_PROCESS_LIMIT
+#endif
+
+#if defined(RGB_MATRIX_GOVERNOR) || (defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL)
+#    define RGB_MATRIX_USE_LIMITS(min, max) LIGHTING_USE_LIMITS(min, max, RGB_MATRIX_PROCESS_LIMIT)
 #else
 #    define RGB_MATRIX_USE_LIMITS(min, max) \
         uint8_t min = 0;                    \
@@ -63,8 +76,7 @@
         rgb_matrix_set_color(i, r, g, b);          \
     }
 
-#define RGB_MATRIX_TEST_LED_FLAGS() \
-    if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+#define RGB_MATRIX_TEST_LED_FLAGS() LIGHTING_TEST_LED_FLAGS()
 
 enum rgb_matrix_effects {
     RGB_MATRIX_NONE = 0,
@@ -99,6 +111,15 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_set_color16(int index, RGB16 color);
+
+// HSV to RGB conversion for the effects, the first two can be overridden by the keyboard
+RGB   rgb_matrix_hsv_to_rgb(HSV hsv);
+void  rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count);
+RGB16 rgb_matrix_hsv_to_rgb16(HSV hsv);
+
+// Random bytes for effects, from the random driver or, with RGB_MATRIX_SPLIT_LOCKSTEP, from the seed both halves share
+void rgb_matrix_random_fill(void *data, size_t size);
 
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
@@ -160,6 +181,13 @@ void        rgb_matrix_decrease_speed_noeeprom(void);
 led_flags_t rgb_matrix_get_flags(void);
 void        rgb_matrix_set_flags(led_flags_t flags);
 
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+const rgb_lockstep_frame_t * rgb_matrix_get_lockstep_frame(void);
+const rgb_lockstep_events_t *rgb_matrix_get_lockstep_events(void);
+void                         rgb_matrix_update_lockstep_frame(const rgb_lockstep_frame_t *frame);
+void                         rgb_matrix_update_lockstep_events(const rgb_lockstep_events_t *events);
+#endif
+
 #ifndef RGBLIGHT_ENABLE
 #    define eeconfig_update_rgblight_current eeconfig_update_rgb_matrix
 #    define rgblight_toggle rgb_matrix_toggle
@@ -218,11 +246,13 @@ extern const rgb_matrix_driver_t rgb_matrix_driver;
 
 extern rgb_config_t rgb_matrix_config;
 
-extern uint32_t     g_rgb_timer;
-extern led_config_t g_led_config;
+extern uint32_t g_rgb_timer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_POLAR_TABLE
+extern led_polar_t g_led_polar[DRIVER_LED_TOTAL];
+#endif
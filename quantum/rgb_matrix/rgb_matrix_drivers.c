@@ -211,8 +211,8 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .set_color_all = AW20216_set_color_all,
 };
 
-#elif defined(WS2812)
-#    if defined(RGBLIGHT_ENABLE) && !defined(RGBLIGHT_CUSTOM_DRIVER)
+#elif defined(WS2812) || defined(APA102)
+#    if defined(WS2812) && defined(RGBLIGHT_ENABLE) && !defined(RGBLIGHT_CUSTOM_DRIVER)
 #        pragma message "Cannot use RGBLIGHT and RGB Matrix using WS2812 at the same time."
 #        pragma message "You need to use a custom driver, or re-implement the WS2812 driver to use a different configuration."
 #    endif
@@ -224,7 +224,11 @@ static void init(void) {}
 
 static void flush(void) {
     // Assumes use of RGB_DI_PIN
+#    ifdef APA102
+    apa102_setleds(rgb_matrix_ws2812_array, DRIVER_LED_TOTAL);
+#    else
     ws2812_setleds(rgb_matrix_ws2812_array, DRIVER_LED_TOTAL);
+#    endif
 }
 
 // Set an led in the buffer to a color
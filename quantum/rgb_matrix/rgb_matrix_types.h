@@ -19,6 +19,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "color.h"
+#include "lighting_types.h"
 
 #if defined(__GNUC__)
 #    define PACKED __attribute__((__packed__))
@@ -34,53 +35,40 @@
 #    define RGB_MATRIX_KEYREACTIVE_ENABLED
 #endif
 
-// Last led hit
-#ifndef LED_HITS_TO_REMEMBER
-#    define LED_HITS_TO_REMEMBER 8
-#endif  // LED_HITS_TO_REMEMBER
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+// Key events the master keeps around for the slave, must be a power of two
+#    ifndef RGB_MATRIX_LOCKSTEP_EVENTS
+#        define RGB_MATRIX_LOCKSTEP_EVENTS 4
+#    endif  // RGB_MATRIX_LOCKSTEP_EVENTS
 
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 typedef struct PACKED {
-    uint8_t  count;
-    uint8_t  x[LED_HITS_TO_REMEMBER];
-    uint8_t  y[LED_HITS_TO_REMEMBER];
-    uint8_t  index[LED_HITS_TO_REMEMBER];
-    uint16_t tick[LED_HITS_TO_REMEMBER];
-} last_hit_t;
-#endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
-
-typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
-
-typedef uint8_t led_flags_t;
+    uint32_t timer;
+    uint32_t seed;
+} rgb_lockstep_frame_t;
 
 typedef struct PACKED {
-    uint8_t     iter;
-    led_flags_t flags;
-    bool        init;
-} effect_params_t;
+    uint8_t  row;
+    uint8_t  col : 7;
+    uint8_t  pressed : 1;
+    uint16_t time;
+} rgb_lockstep_event_t;
 
 typedef struct PACKED {
-    uint8_t x;
-    uint8_t y;
-} led_point_t;
-
-#define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
-#define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
+    uint8_t              count;  // total number of events recorded, wrapping
+    rgb_lockstep_event_t events[RGB_MATRIX_LOCKSTEP_EVENTS];
+} rgb_lockstep_events_t;
+#endif  // RGB_MATRIX_SPLIT_LOCKSTEP
 
-#define LED_FLAG_ALL 0xFF
-#define LED_FLAG_NONE 0x00
-#define LED_FLAG_MODIFIER 0x01
-#define LED_FLAG_UNDERGLOW 0x02
-#define LED_FLAG_KEYLIGHT 0x04
-#define LED_FLAG_INDICATOR 0x08
-
-#define NO_LED 255
+typedef lighting_task_states rgb_task_states;
 
+// Angle and distance of an LED around the center, as used by the geometric effects
 typedef struct PACKED {
-    uint8_t     matrix_co[MATRIX_ROWS][MATRIX_COLS];
-    led_point_t point[DRIVER_LED_TOTAL];
-    uint8_t     flags[DRIVER_LED_TOTAL];
-} led_config_t;
+    uint8_t angle;
+    uint8_t dist;
+} led_polar_t;
+
+// A keyframe animation, the palette holds red, green and blue of every color
+typedef lighting_keyframes_t rgb_matrix_keyframes_t;
 
 typedef union {
     uint32_t raw;
@@ -23,6 +23,7 @@
 #include "color.h"
 #include "debug.h"
 #include "led_tables.h"
+#include "rgb_current.h"
 #include <lib/lib8tion/lib8tion.h>
 #ifdef EEPROM_ENABLE
 #    include "eeprom.h"
@@ -128,6 +129,24 @@ LED_TYPE led[RGBLED_NUM];
 rgblight_segment_t const *const *rgblight_layers = NULL;
 #endif
 
+#ifdef RGBLIGHT_COMPOSITE
+// The frame that last went out to the driver, so the same frame is never sent twice
+static LED_TYPE rgblight_sent[RGBLED_NUM];
+static uint8_t  rgblight_sent_leds = 0;
+
+#    ifdef RGBLIGHT_LAYERS
+// The enabled layers drawn on their own, with a bit per LED they cover, redrawn only when the layers change
+static LED_TYPE                         layer_frame[RGBLED_NUM];
+static uint8_t                          layer_covered[(RGBLED_NUM + 7) / 8];
+static bool                             layer_frame_valid = false;
+static rgblight_layer_mask_t            layer_frame_mask;
+static rgblight_segment_t const *const *layer_frame_layers;
+#        ifdef RGBLIGHT_LAYERS_RETAIN_VAL
+static uint8_t layer_frame_val;
+#        endif
+#    endif
+#endif
+
 rgblight_ranges_t rgblight_ranges = {0, RGBLED_NUM, 0, RGBLED_NUM, RGBLED_NUM};
 
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds) {
@@ -141,6 +160,9 @@ void rgblight_set_effect_range(uint8_t start_pos, uint8_t num_leds) {
     rgblight_ranges.effect_start_pos = start_pos;
     rgblight_ranges.effect_end_pos   = start_pos + num_leds;
     rgblight_ranges.effect_num_leds  = num_leds;
+#ifdef RGBLIGHT_USE_TIMER
+    animation_status.redraw = true;
+#endif
 }
 
 __attribute__((weak)) RGB rgblight_hsv_to_rgb(HSV hsv) { return hsv_to_rgb(hsv); }
@@ -527,6 +549,9 @@ void rgblight_sethsv_eeprom_helper(uint8_t hue, uint8_t sat, uint8_t val, bool w
         if (rgblight_config.hue != hue || rgblight_config.sat != sat || rgblight_config.val != val) {
             RGBLIGHT_SPLIT_SET_CHANGE_HSVS;
         }
+#endif
+#ifdef RGBLIGHT_USE_TIMER
+        animation_status.redraw = true;
 #endif
         rgblight_config.hue = hue;
         rgblight_config.sat = sat;
@@ -668,7 +693,14 @@ void rgblight_set_layer_state(uint8_t layer, bool enabled) {
     RGBLIGHT_SPLIT_SET_CHANGE_LAYERS;
     // Static modes don't have a ticker running to update the LEDs
     if (rgblight_status.timer_enabled == false) {
+#    ifdef RGBLIGHT_COMPOSITE
+        // led[] still holds the effect frame, only the layers over it need drawing again
+        if (rgblight_config.enable) {
+            rgblight_set();
+        }
+#    else
         rgblight_mode_noeeprom(rgblight_config.mode);
+#    endif
     }
 
 #    ifdef RGBLIGHT_LAYERS_OVERRIDE_RGB_OFF
@@ -684,8 +716,8 @@ bool rgblight_get_layer_state(uint8_t layer) {
     return (rgblight_status.enabled_layer_mask & mask) != 0;
 }
 
-// Write any enabled LED layers into the buffer
-static void rgblight_layers_write(void) {
+// Write any enabled LED layers into the buffer, marking the LEDs they cover in covered unless it is NULL
+static void rgblight_layers_write(LED_TYPE *frame, uint8_t *covered) {
 #    ifdef RGBLIGHT_LAYERS_RETAIN_VAL
     uint8_t current_val = rgblight_get_val();
 #    endif
@@ -707,19 +739,40 @@ static void rgblight_layers_write(void) {
                 break;  // No more segments
             }
             // Write segment.count LEDs
-            LED_TYPE *const limit = &led[MIN(segment.index + segment.count, RGBLED_NUM)];
-            for (LED_TYPE *led_ptr = &led[segment.index]; led_ptr < limit; led_ptr++) {
+            LED_TYPE *const limit = &frame[MIN(segment.index + segment.count, RGBLED_NUM)];
+            for (LED_TYPE *led_ptr = &frame[segment.index]; led_ptr < limit; led_ptr++) {
 #    ifdef RGBLIGHT_LAYERS_RETAIN_VAL
                 sethsv(segment.hue, segment.sat, current_val, led_ptr);
 #    else
                 sethsv(segment.hue, segment.sat, segment.val, led_ptr);
 #    endif
+                if (covered) {
+                    uint8_t index = led_ptr - frame;
+                    covered[index / 8] |= 1 << (index % 8);
+                }
             }
             segment_ptr++;
         }
     }
 }
 
+#    ifdef RGBLIGHT_COMPOSITE
+// Redraws layer_frame if the enabled layers, or the brightness they use, changed since it was last drawn
+static void rgblight_layers_update(void) {
+#        ifdef RGBLIGHT_LAYERS_RETAIN_VAL
+    if (layer_frame_valid && layer_frame_mask == rgblight_status.enabled_layer_mask && layer_frame_layers == rgblight_layers && layer_frame_val == rgblight_get_val()) return;
+    layer_frame_val = rgblight_get_val();
+#        else
+    if (layer_frame_valid && layer_frame_mask == rgblight_status.enabled_layer_mask && layer_frame_layers == rgblight_layers) return;
+#        endif
+    layer_frame_mask   = rgblight_status.enabled_layer_mask;
+    layer_frame_layers = rgblight_layers;
+    layer_frame_valid  = true;
+    memset(layer_covered, 0, sizeof(layer_covered));
+    rgblight_layers_write(layer_frame, layer_covered);
+}
+#    endif
+
 #    ifdef RGBLIGHT_LAYER_BLINK
 rgblight_layer_mask_t _blinking_layer_mask = 0;
 static uint16_t       _repeat_timer;
@@ -800,8 +853,43 @@ __attribute__((weak)) void rgblight_call_driver(LED_TYPE *start_led, uint8_t num
 
 #ifndef RGBLIGHT_CUSTOM_DRIVER
 
+#    ifdef RGBLIGHT_COMPOSITE
+// Returns the frame to show, led[] itself when no layer is drawn over it or else the layers put over a copy of it in frame
+static LED_TYPE *rgblight_compose(LED_TYPE *frame) {
+#        ifdef RGBLIGHT_LAYERS
+    if (rgblight_layers == NULL || rgblight_status.enabled_layer_mask == 0
+#            if !defined(RGBLIGHT_LAYERS_OVERRIDE_RGB_OFF)
+        || !rgblight_config.enable
+#            elif defined(RGBLIGHT_SLEEP)
+        || is_suspended
+#            endif
+    ) {
+        return led;
+    }
+    rgblight_layers_update();
+    for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+        frame[i] = layer_covered[i / 8] & (1 << (i % 8)) ? layer_frame[i] : led[i];
+    }
+    return frame;
+#        else
+    return led;
+#        endif
+}
+
+// Returns whether this is the frame the driver was last sent, remembering it if not
+static bool rgblight_frame_unchanged(const LED_TYPE *start_led, uint8_t num_leds) {
+    if (num_leds == rgblight_sent_leds && memcmp(rgblight_sent, start_led, num_leds * sizeof(LED_TYPE)) == 0) {
+        return true;
+    }
+    memcpy(rgblight_sent, start_led, num_leds * sizeof(LED_TYPE));
+    rgblight_sent_leds = num_leds;
+    return false;
+}
+#    endif
+
 void rgblight_set(void) {
     LED_TYPE *start_led;
+    LED_TYPE *frame    = led;
     uint8_t   num_leds = rgblight_ranges.clipping_num_leds;
 
     if (!rgblight_config.enable) {
@@ -815,7 +903,10 @@ void rgblight_set(void) {
         }
     }
 
-#    ifdef RGBLIGHT_LAYERS
+#    if defined(RGBLIGHT_COMPOSITE)
+    LED_TYPE composed[RGBLED_NUM];
+    frame = rgblight_compose(composed);
+#    elif defined(RGBLIGHT_LAYERS)
     if (rgblight_layers != NULL
 #        if !defined(RGBLIGHT_LAYERS_OVERRIDE_RGB_OFF)
         && rgblight_config.enable
@@ -823,24 +914,48 @@ void rgblight_set(void) {
         && !is_suspended
 #        endif
     ) {
-        rgblight_layers_write();
+        rgblight_layers_write(led, NULL);
     }
 #    endif
 
 #    ifdef RGBLIGHT_LED_MAP
     LED_TYPE led0[RGBLED_NUM];
     for (uint8_t i = 0; i < RGBLED_NUM; i++) {
-        led0[i] = led[pgm_read_byte(&led_map[i])];
+        led0[i] = frame[pgm_read_byte(&led_map[i])];
     }
     start_led = led0 + rgblight_ranges.clipping_start_pos;
 #    else
-    start_led = led + rgblight_ranges.clipping_start_pos;
+    start_led = frame + rgblight_ranges.clipping_start_pos;
+#    endif
+
+#    ifdef RGB_CURRENT_BUDGET_MA
+    // Send a scaled down copy when the frame would draw more than the budget, led[] keeps the colors as set
+    LED_TYPE limited[RGBLED_NUM];
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < num_leds; i++) {
+        total += rgb_current_of(start_led[i].r, start_led[i].g, start_led[i].b);
+    }
+    uint16_t scale = rgb_current_scale(total, num_leds);
+    if (scale < 256) {
+        for (uint8_t i = 0; i < num_leds; i++) {
+            limited[i]   = start_led[i];
+            limited[i].r = start_led[i].r * scale >> 8;
+            limited[i].g = start_led[i].g * scale >> 8;
+            limited[i].b = start_led[i].b * scale >> 8;
+        }
+        start_led = limited;
+    }
 #    endif
 
 #    ifdef RGBW
     for (uint8_t i = 0; i < num_leds; i++) {
         convert_rgb_to_rgbw(&start_led[i]);
     }
+#    endif
+#    ifdef RGBLIGHT_COMPOSITE
+    if (rgblight_frame_unchanged(start_led, num_leds)) {
+        return;
+    }
 #    endif
     rgblight_call_driver(start_led, num_leds);
 }
@@ -862,6 +977,12 @@ void rgblight_update_sync(rgblight_syncinfo_t *syncinfo, bool write_to_eeprom) {
 #    ifdef RGBLIGHT_LAYERS
     if (syncinfo->status.change_flags & RGBLIGHT_STATUS_CHANGE_LAYERS) {
         rgblight_status.enabled_layer_mask = syncinfo->status.enabled_layer_mask;
+#        ifdef RGBLIGHT_COMPOSITE
+        // A static mode on the master no longer sends a mode change along with the layers, so redraw them here
+        if (rgblight_status.timer_enabled == false) {
+            rgblight_set();
+        }
+#        endif
     }
 #    endif
     if (syncinfo->status.change_flags & RGBLIGHT_STATUS_CHANGE_MODE) {
@@ -942,10 +1063,31 @@ static void rgblight_effect_dummy(animation_status_t *anim) {
     **/
 }
 
+/* Returns the steps a time based effect has taken, in 16.16 fixed point, at one step per interval
+ * milliseconds. It only depends on the synced time and the current speed, both of which the halves
+ * of a split keyboard share, so they always agree on it. 2^32 wraps to a whole number of 256 step
+ * cycles. A speed change makes the effect jump to where the new speed would have got to.
+ */
+static uint32_t rgblight_effect_phase(uint16_t interval) {
+    uint32_t rate = ((uint32_t)1 << 16) / interval;
+    return sync_timer_read32() * rate;
+}
+
+// Returns whether a time based effect showing output would draw what it already drew, remembering output if not
+static bool rgblight_effect_unchanged(animation_status_t *anim, uint16_t output) {
+    if (!anim->redraw && anim->drawn == output) {
+        return true;
+    }
+    anim->drawn  = output;
+    anim->redraw = false;
+    return false;
+}
+
 void rgblight_task(void) {
     if (rgblight_status.timer_enabled) {
         effect_func_t effect_func   = rgblight_effect_dummy;
         uint16_t      interval_time = 2000;  // dummy interval
+        bool          time_based    = false;
         uint8_t       delta         = rgblight_config.mode - rgblight_status.base_mode;
         animation_status.delta      = delta;
 
@@ -957,6 +1099,7 @@ void rgblight_task(void) {
             // breathing mode
             interval_time = get_interval_time(&RGBLED_BREATHING_INTERVALS[delta], 1, 100);
             effect_func   = rgblight_effect_breathing;
+            time_based    = true;
         }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_RAINBOW_MOOD
@@ -964,6 +1107,7 @@ void rgblight_task(void) {
             // rainbow mood mode
             interval_time = get_interval_time(&RGBLED_RAINBOW_MOOD_INTERVALS[delta], 5, 100);
             effect_func   = rgblight_effect_rainbow_mood;
+            time_based    = true;
         }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_RAINBOW_SWIRL
@@ -971,6 +1115,7 @@ void rgblight_task(void) {
             // rainbow swirl mode
             interval_time = get_interval_time(&RGBLED_RAINBOW_SWIRL_INTERVALS[delta / 2], 1, 100);
             effect_func   = rgblight_effect_rainbow_swirl;
+            time_based    = true;
         }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_SNAKE
@@ -1017,9 +1162,15 @@ void rgblight_task(void) {
             animation_status.restart    = false;
             animation_status.last_timer = sync_timer_read();
             animation_status.pos16      = 0;  // restart signal to local each effect
+            animation_status.redraw     = true;
         }
         uint16_t now = sync_timer_read();
-        if (timer_expired(now, animation_status.last_timer)) {
+        if (time_based) {
+            // Worked out on every run, the effect only draws when that changes what is shown.
+            // Needs no animation tick on a split keyboard, as the phase follows the synced time.
+            animation_status.phase = rgblight_effect_phase(interval_time);
+            effect_func(&animation_status);
+        } else if (timer_expired(now, animation_status.last_timer)) {
 #    if defined(RGBLIGHT_SPLIT) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
             static uint16_t report_last_timer = 0;
             static bool     tick_flag         = false;
@@ -1077,9 +1228,13 @@ static uint8_t breathe_calc(uint8_t pos) {
 __attribute__((weak)) const uint8_t RGBLED_BREATHING_INTERVALS[] PROGMEM = {30, 20, 10, 5};
 
 void rgblight_effect_breathing(animation_status_t *anim) {
-    uint8_t val = breathe_calc(anim->pos);
+    // Blend towards the next step by the fraction of it that has passed
+    uint8_t pos = anim->phase >> 16;
+    uint8_t val = lerp8by8(breathe_calc(pos), breathe_calc(pos + 1), anim->phase >> 8);
+    if (rgblight_effect_unchanged(anim, val)) {
+        return;
+    }
     rgblight_sethsv_noeeprom_old(rgblight_config.hue, rgblight_config.sat, val);
-    anim->pos = (anim->pos + 1);
 }
 #endif
 
@@ -1087,8 +1242,11 @@ void rgblight_effect_breathing(animation_status_t *anim) {
 __attribute__((weak)) const uint8_t RGBLED_RAINBOW_MOOD_INTERVALS[] PROGMEM = {120, 60, 30};
 
 void rgblight_effect_rainbow_mood(animation_status_t *anim) {
-    rgblight_sethsv_noeeprom_old(anim->current_hue, rgblight_config.sat, rgblight_config.val);
-    anim->current_hue++;
+    uint8_t hue = anim->phase >> 16;
+    if (rgblight_effect_unchanged(anim, hue)) {
+        return;
+    }
+    rgblight_sethsv_noeeprom_old(hue, rgblight_config.sat, rgblight_config.val);
 }
 #endif
 
@@ -1102,18 +1260,19 @@ __attribute__((weak)) const uint8_t RGBLED_RAINBOW_SWIRL_INTERVALS[] PROGMEM = {
 void rgblight_effect_rainbow_swirl(animation_status_t *anim) {
     uint8_t hue;
     uint8_t i;
+    uint8_t offset = anim->phase >> 16;
 
+    if (anim->delta % 2 == 0) {
+        offset = -offset;
+    }
+    if (rgblight_effect_unchanged(anim, offset)) {
+        return;
+    }
     for (i = 0; i < rgblight_ranges.effect_num_leds; i++) {
-        hue = (RGBLIGHT_RAINBOW_SWIRL_RANGE / rgblight_ranges.effect_num_leds * i + anim->current_hue);
+        hue = (RGBLIGHT_RAINBOW_SWIRL_RANGE / rgblight_ranges.effect_num_leds * i + offset);
         sethsv(hue, rgblight_config.sat, rgblight_config.val, (LED_TYPE *)&led[i + rgblight_ranges.effect_start_pos]);
     }
     rgblight_set();
-
-    if (anim->delta % 2) {
-        anim->current_hue++;
-    } else {
-        anim->current_hue--;
-    }
 }
 #endif
 
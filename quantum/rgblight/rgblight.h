@@ -167,6 +167,11 @@ enum RGBLIGHT_EFFECT_MODE {
 #    define RGBLIGHT_LIMIT_VAL 255
 #endif
 
+// RGBLIGHT_COMPOSITE keeps the layers apart from the effect frame in led[], which needs the rgblight_set() below
+#if defined(RGBLIGHT_COMPOSITE) && defined(RGBLIGHT_CUSTOM_DRIVER)
+#    error "RGBLIGHT_COMPOSITE cannot be used with RGBLIGHT_CUSTOM_DRIVER"
+#endif
+
 #include <stdint.h>
 #include <stdbool.h>
 #include "progmem.h"
@@ -417,6 +422,12 @@ typedef struct _animation_status_t {
         int8_t   current_hue;
         uint16_t current_offset;
     };
+    /* Time based effects: steps taken so far in 16.16 fixed point, worked out from
+     * the synced time on every task run, and what they last drew.
+     */
+    uint32_t phase;
+    uint16_t drawn;
+    bool     redraw;
 } animation_status_t;
 
 extern animation_status_t animation_status;
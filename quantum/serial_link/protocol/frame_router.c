@@ -30,6 +30,42 @@ static bool is_master;
 
 void router_set_master(bool master) { is_master = master; }
 
+#ifdef SERIAL_LINK_SHARED_BUS
+_Static_assert(NUM_SLAVES < SHARED_BUS_BROADCAST, "NUM_SLAVES too large for the shared bus addresses");
+
+static uint8_t bus_address;
+
+void router_set_address(uint8_t address) { bus_address = address; }
+
+// Every node hears every frame, so instead of counting hops the last byte holds the
+// address of the module, with SHARED_BUS_TO_MASTER set on the way back to the master
+void route_incoming_frame(uint8_t link, uint8_t* data, uint16_t size) {
+    (void)link;
+    uint8_t address = data[size - 1];
+    if (is_master) {
+        uint8_t from = address & ~SHARED_BUS_TO_MASTER;
+        if ((address & SHARED_BUS_TO_MASTER) && from >= 1 && from <= NUM_SLAVES) {
+            transport_recv_frame(from, data, size - 1);
+        }
+    } else if (address == bus_address || address == SHARED_BUS_BROADCAST) {
+        transport_recv_frame(0, data, size - 1);
+    }
+}
+
+void router_send_frame(uint8_t destination, uint8_t* data, uint16_t size) {
+    if (destination == 0) {
+        if (!is_master) {
+            data[size] = SHARED_BUS_TO_MASTER | bus_address;
+            validator_send_frame(UP_LINK, data, size + 1);
+        }
+    } else {
+        if (is_master) {
+            data[size] = destination == 0xFF ? SHARED_BUS_BROADCAST : destination;
+            validator_send_frame(DOWN_LINK, data, size + 1);
+        }
+    }
+}
+#else
 void route_incoming_frame(uint8_t link, uint8_t* data, uint16_t size) {
     if (is_master) {
         if (link == DOWN_LINK) {
@@ -62,3 +98,4 @@ void router_send_frame(uint8_t destination, uint8_t* data, uint16_t size) {
         }
     }
 }
+#endif
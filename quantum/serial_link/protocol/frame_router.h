@@ -30,6 +30,11 @@ SOFTWARE.
 #define UP_LINK 0
 #define DOWN_LINK 1
 
+// Addresses on a SERIAL_LINK_SHARED_BUS, modules are 1 to NUM_SLAVES
+#define SHARED_BUS_TO_MASTER 0x80
+#define SHARED_BUS_BROADCAST 0x7F
+
 void router_set_master(bool master);
+void router_set_address(uint8_t address);
 void route_incoming_frame(uint8_t link, uint8_t* data, uint16_t size);
 void router_send_frame(uint8_t destination, uint8_t* data, uint16_t size);
@@ -27,7 +27,9 @@ SOFTWARE.
 #include "serial_link/protocol/triple_buffered_object.h"
 #include "serial_link/system/serial_link.h"
 
-#define NUM_SLAVES 8
+#ifndef NUM_SLAVES
+#    define NUM_SLAVES 8
+#endif
 #define LOCAL_OBJECT_EXTRA 16
 
 // master -> slave = 1 local(target all), 1 remote object
@@ -48,18 +50,17 @@ typedef struct {
 #define REMOTE_OBJECT_SIZE(objectsize) (sizeof(triple_buffer_object_t) + objectsize * 3)
 #define LOCAL_OBJECT_SIZE(objectsize) (sizeof(triple_buffer_object_t) + (objectsize + LOCAL_OBJECT_EXTRA) * 3)
 
-#define REMOTE_OBJECT_HELPER(name, type, num_local, num_remote)                                                              \
-    typedef struct {                                                                                                         \
-        remote_object_t object;                                                                                              \
-        uint8_t         buffer[num_remote * REMOTE_OBJECT_SIZE(sizeof(type)) + num_local * LOCAL_OBJECT_SIZE(sizeof(type))]; \
+// Same layout as remote_object_t, with the buffer sized, as C++ doesn't allow a struct ending in a flexible array inside another one
+#define REMOTE_OBJECT_HELPER(name, type, num_local, num_remote)                                                                                           \
+    typedef struct {                                                                                                                                      \
+        remote_object_type object_type;                                                                                                                   \
+        uint16_t           object_size;                                                                                                                   \
+        uint8_t            buffer[num_remote * REMOTE_OBJECT_SIZE(sizeof(type)) + num_local * LOCAL_OBJECT_SIZE(sizeof(type))] __attribute__((aligned(4))); \
     } remote_object_##name##_t;
 
 #define MASTER_TO_ALL_SLAVES_OBJECT(name, type)                                                                     \
     REMOTE_OBJECT_HELPER(name, type, 1, 1)                                                                          \
-    remote_object_##name##_t remote_object_##name = {.object = {                                                    \
-                                                         .object_type = MASTER_TO_ALL_SLAVES,                       \
-                                                         .object_size = sizeof(type),                               \
-                                                     }};                                                            \
+    remote_object_##name##_t remote_object_##name = {.object_type = MASTER_TO_ALL_SLAVES, .object_size = sizeof(type)}; \
     type*                    begin_write_##name(void) {                                                             \
         remote_object_t*        obj = (remote_object_t*)&remote_object_##name;                   \
         triple_buffer_object_t* tb  = (triple_buffer_object_t*)obj->buffer;                      \
@@ -80,10 +81,7 @@ typedef struct {
 
 #define MASTER_TO_SINGLE_SLAVE_OBJECT(name, type)                                                                   \
     REMOTE_OBJECT_HELPER(name, type, NUM_SLAVES, 1)                                                                 \
-    remote_object_##name##_t remote_object_##name = {.object = {                                                    \
-                                                         .object_type = MASTER_TO_SINGLE_SLAVE,                     \
-                                                         .object_size = sizeof(type),                               \
-                                                     }};                                                            \
+    remote_object_##name##_t remote_object_##name = {.object_type = MASTER_TO_SINGLE_SLAVE, .object_size = sizeof(type)}; \
     type*                    begin_write_##name(uint8_t slave) {                                                    \
         remote_object_t* obj   = (remote_object_t*)&remote_object_##name;                        \
         uint8_t*         start = obj->buffer;                                                    \
@@ -108,10 +106,7 @@ typedef struct {
 
 #define SLAVE_TO_MASTER_OBJECT(name, type)                                                                          \
     REMOTE_OBJECT_HELPER(name, type, 1, NUM_SLAVES)                                                                 \
-    remote_object_##name##_t remote_object_##name = {.object = {                                                    \
-                                                         .object_type = SLAVE_TO_MASTER,                            \
-                                                         .object_size = sizeof(type),                               \
-                                                     }};                                                            \
+    remote_object_##name##_t remote_object_##name = {.object_type = SLAVE_TO_MASTER, .object_size = sizeof(type)}; \
     type*                    begin_write_##name(void) {                                                             \
         remote_object_t*        obj = (remote_object_t*)&remote_object_##name;                   \
         triple_buffer_object_t* tb  = (triple_buffer_object_t*)obj->buffer;                      \
@@ -57,6 +57,43 @@ host_driver_t serial_driver = {keyboard_leds, send_keyboard, send_mouse, send_sy
 #    error "Serial link thread priority not set"
 #endif
 
+// Number of modules on the link the master collects matrix data from, each
+// handed to matrix_set_remote() with its own index
+#ifndef SERIAL_LINK_NUM_MODULES
+#    define SERIAL_LINK_NUM_MODULES 1
+#endif
+
+_Static_assert(SERIAL_LINK_NUM_MODULES <= NUM_SLAVES, "SERIAL_LINK_NUM_MODULES exceeds NUM_SLAVES");
+
+// Modules resend an unchanged matrix at this interval
+#ifndef SERIAL_LINK_MATRIX_REFRESH_US
+#    define SERIAL_LINK_MATRIX_REFRESH_US 5000
+#endif
+
+#ifdef SERIAL_LINK_SHARED_BUS
+// Address of this module on the bus, unique for every module
+#    ifndef SERIAL_LINK_MODULE_ADDRESS
+#        define SERIAL_LINK_MODULE_ADDRESS 1
+#    endif
+
+_Static_assert(SERIAL_LINK_MODULE_ADDRESS >= 1 && SERIAL_LINK_MODULE_ADDRESS <= NUM_SLAVES, "SERIAL_LINK_MODULE_ADDRESS must be between 1 and NUM_SLAVES");
+
+// The master moves on to the next module when the polled one doesn't answer within this time
+#    ifndef SERIAL_LINK_POLL_TIMEOUT_US
+#        define SERIAL_LINK_POLL_TIMEOUT_US 2000
+#    endif
+
+// A module that hasn't sent anything for this long gets its keys released
+#    ifndef SERIAL_LINK_MODULE_TIMEOUT_US
+#        define SERIAL_LINK_MODULE_TIMEOUT_US (4 * SERIAL_LINK_NUM_MODULES * SERIAL_LINK_POLL_TIMEOUT_US)
+#    endif
+#else
+// A module that hasn't sent anything for this long gets its keys released
+#    ifndef SERIAL_LINK_MODULE_TIMEOUT_US
+#        define SERIAL_LINK_MODULE_TIMEOUT_US (4 * SERIAL_LINK_MATRIX_REFRESH_US)
+#    endif
+#endif
+
 static SerialConfig config = {.sc_speed = SERIAL_LINK_BAUD};
 
 //#define DEBUG_LINK_ERRORS
@@ -160,11 +197,32 @@ typedef struct {
 
 static matrix_object_t last_matrix = {};
 
+typedef struct {
+    systime_t last_seen;
+    bool      active;
+} module_state_t;
+
+static module_state_t module_state[SERIAL_LINK_NUM_MODULES] = {};
+
+#ifdef SERIAL_LINK_REMOTE_MATRIX
+static matrix_row_t remote_matrix[SERIAL_LINK_NUM_MODULES][MATRIX_ROWS];
+#endif
+
+#ifdef SERIAL_LINK_SHARED_BUS
+// The module the master is waiting on, modules only send when asked so they never talk over each other
+static uint8_t   poll_module  = SERIAL_LINK_NUM_MODULES - 1;
+static bool      poll_pending = false;
+static systime_t poll_start;
+#endif
+
 SLAVE_TO_MASTER_OBJECT(keyboard_matrix, matrix_object_t);
 MASTER_TO_ALL_SLAVES_OBJECT(serial_link_connected, bool);
 #ifndef DISABLE_SYNC_TIMER
 MASTER_TO_ALL_SLAVES_OBJECT(sync_timer, uint32_t);
 #endif
+#ifdef SERIAL_LINK_SHARED_BUS
+MASTER_TO_SINGLE_SLAVE_OBJECT(matrix_poll, uint8_t);
+#endif
 
 static remote_object_t* remote_objects[] = {
     REMOTE_OBJECT(serial_link_connected),
@@ -172,12 +230,18 @@ static remote_object_t* remote_objects[] = {
 #ifndef DISABLE_SYNC_TIMER
     REMOTE_OBJECT(sync_timer),
 #endif
+#ifdef SERIAL_LINK_SHARED_BUS
+    REMOTE_OBJECT(matrix_poll),
+#endif
 };
 
 void init_serial_link(void) {
     serial_link_connected = false;
     init_serial_link_hal();
     add_remote_objects(remote_objects, sizeof(remote_objects) / sizeof(remote_object_t*));
+#ifdef SERIAL_LINK_SHARED_BUS
+    router_set_address(SERIAL_LINK_MODULE_ADDRESS);
+#endif
     init_byte_stuffer();
     sdStart(&SD1, &config);
     sdStart(&SD2, &config);
@@ -185,7 +249,39 @@ void init_serial_link(void) {
     (void)chThdCreateStatic(serialThreadStack, sizeof(serialThreadStack), SERIAL_LINK_THREAD_PRIORITY, serialThread, NULL);
 }
 
-void matrix_set_remote(matrix_row_t* rows, uint8_t index);
+#ifdef SERIAL_LINK_REMOTE_MATRIX
+void matrix_set_remote(matrix_row_t* rows, uint8_t index) {
+    for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
+        remote_matrix[index][i] = rows[i];
+    }
+}
+
+matrix_row_t serial_link_get_remote_row(uint8_t index, uint8_t row) { return remote_matrix[index][row]; }
+#endif
+
+static void write_matrix(matrix_object_t* matrix) {
+    matrix_object_t* m = begin_write_keyboard_matrix();
+    for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
+        m->rows[i] = matrix->rows[i];
+    }
+    end_write_keyboard_matrix();
+}
+
+#ifdef SERIAL_LINK_SHARED_BUS
+// Polls the modules round robin, so every module is asked at least once every
+// SERIAL_LINK_NUM_MODULES * SERIAL_LINK_POLL_TIMEOUT_US, however many there are
+static void poll_next_module(systime_t current_time) {
+    if (poll_pending && current_time - poll_start <= TIME_US2I(SERIAL_LINK_POLL_TIMEOUT_US)) {
+        return;
+    }
+    poll_module = (poll_module + 1) % SERIAL_LINK_NUM_MODULES;
+    // The address of module i is i + 1, MASTER_TO_SINGLE_SLAVE objects count from 0
+    *begin_write_matrix_poll(poll_module) = 0;
+    end_write_matrix_poll(poll_module);
+    poll_start   = current_time;
+    poll_pending = true;
+}
+#endif
 
 void serial_link_update(void) {
     if (read_serial_link_connected()) {
@@ -201,14 +297,12 @@ void serial_link_update(void) {
 
     systime_t current_time = chVTGetSystemTimeX();
     systime_t delta        = current_time - last_update;
-    if (changed || delta > TIME_US2I(5000)) {
-        last_update        = current_time;
-        last_matrix        = matrix;
-        matrix_object_t* m = begin_write_keyboard_matrix();
-        for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
-            m->rows[i] = matrix.rows[i];
-        }
-        end_write_keyboard_matrix();
+    if (changed || delta > TIME_US2I(SERIAL_LINK_MATRIX_REFRESH_US)) {
+        last_update = current_time;
+        last_matrix = matrix;
+#ifndef SERIAL_LINK_SHARED_BUS
+        write_matrix(&matrix);
+#endif
 
         *begin_write_serial_link_connected() = true;
         end_write_serial_link_connected();
@@ -219,10 +313,37 @@ void serial_link_update(void) {
 #endif
     }
 
-    matrix_object_t* m = read_keyboard_matrix(0);
-    if (m) {
-        matrix_set_remote(m->rows, 0);
+#ifdef SERIAL_LINK_SHARED_BUS
+    // A module answers a poll with its matrix, changed or not
+    if (read_matrix_poll()) {
+        write_matrix(&matrix);
     }
+#endif
+
+    for (uint8_t i = 0; i < SERIAL_LINK_NUM_MODULES; i++) {
+        matrix_object_t* m = read_keyboard_matrix(i);
+        if (m) {
+            matrix_set_remote(m->rows, i);
+            module_state[i].last_seen = current_time;
+            module_state[i].active    = true;
+#ifdef SERIAL_LINK_SHARED_BUS
+            if (i == poll_module) {
+                poll_pending = false;
+            }
+#endif
+        } else if (module_state[i].active && current_time - module_state[i].last_seen > TIME_US2I(SERIAL_LINK_MODULE_TIMEOUT_US)) {
+            // Bound how long keys can stay stuck when a module drops off the link
+            matrix_object_t empty = {};
+            matrix_set_remote(empty.rows, i);
+            module_state[i].active = false;
+        }
+    }
+
+#ifdef SERIAL_LINK_SHARED_BUS
+    if (is_master) {
+        poll_next_module(current_time);
+    }
+#endif
 
 #ifndef DISABLE_SYNC_TIMER
     uint32_t* t = read_sync_timer();
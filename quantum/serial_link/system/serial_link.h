@@ -25,6 +25,7 @@ SOFTWARE.
 #pragma once
 
 #include "host_driver.h"
+#include "matrix.h"
 #include <stdbool.h>
 
 void           init_serial_link(void);
@@ -34,6 +35,13 @@ bool           is_serial_link_master(void);
 host_driver_t* get_serial_link_driver(void);
 void           serial_link_update(void);
 
+// Called on the master with the matrix of module `index`. Implemented by the keyboard, or with
+// SERIAL_LINK_REMOTE_MATRIX by the serial link, which keeps a copy for serial_link_get_remote_row().
+void matrix_set_remote(matrix_row_t* rows, uint8_t index);
+#ifdef SERIAL_LINK_REMOTE_MATRIX
+matrix_row_t serial_link_get_remote_row(uint8_t index, uint8_t row);
+#endif
+
 #if defined(PROTOCOL_CHIBIOS)
 #    include <ch.h>
 
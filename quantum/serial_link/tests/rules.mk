@@ -12,6 +12,14 @@ serial_link_frame_router_SRC := \
 	$(SERIAL_PATH)/protocol/frame_validator.c \
 	$(SERIAL_PATH)/protocol/frame_router.c
 
+serial_link_shared_bus_router_DEFS := -DSERIAL_LINK_SHARED_BUS
+
+serial_link_shared_bus_router_SRC := \
+	$(SERIAL_PATH)/tests/shared_bus_router_tests.cpp \
+	$(SERIAL_PATH)/protocol/byte_stuffer.c \
+	$(SERIAL_PATH)/protocol/frame_validator.c \
+	$(SERIAL_PATH)/protocol/frame_router.c
+
 serial_link_triple_buffered_object_SRC := \
 	$(SERIAL_PATH)/tests/triple_buffered_object_tests.cpp \
 	$(SERIAL_PATH)/protocol/triple_buffered_object.c 
@@ -0,0 +1,165 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2016 Fred Sundvik
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <array>
+extern "C" {
+#include "serial_link/protocol/transport.h"
+#include "serial_link/protocol/byte_stuffer.h"
+#include "serial_link/protocol/frame_router.h"
+}
+
+using testing::_;
+using testing::Args;
+using testing::ElementsAreArray;
+
+// Node 0 is the master, node n the module with address n. They all share one bus, the
+// master on its DOWN_LINK and the modules on their UP_LINK.
+class SharedBusRouter : public testing::Test {
+   public:
+    SharedBusRouter() : current_node(0) {
+        Instance = this;
+        init_byte_stuffer();
+    }
+
+    ~SharedBusRouter() { Instance = nullptr; }
+
+    void send_data(uint8_t link, const uint8_t* data, uint16_t size) {
+        auto& buffer = sent[current_node][link];
+        std::copy(data, data + size, std::back_inserter(buffer));
+    }
+
+    void activate_node(uint8_t num) {
+        current_node = num;
+        router_set_master(num == 0);
+        router_set_address(num);
+    }
+
+    // Delivers what node `from` put on the bus to node `to`
+    void simulate_bus(uint8_t from, uint8_t to) {
+        auto& buffer = sent[from][from == 0 ? DOWN_LINK : UP_LINK];
+        activate_node(to);
+        uint8_t link = to == 0 ? DOWN_LINK : UP_LINK;
+        for (uint8_t byte : buffer) {
+            byte_stuffer_recv_byte(link, byte);
+        }
+    }
+
+    MOCK_METHOD3(transport_recv_frame, void(uint8_t from, uint8_t* data, uint16_t size));
+
+    std::vector<uint8_t> sent[4][2];
+    uint8_t              current_node;
+
+    static SharedBusRouter* Instance;
+};
+
+SharedBusRouter* SharedBusRouter::Instance = nullptr;
+
+typedef struct {
+    std::array<uint8_t, 4> data;
+    uint8_t                extra[16];
+} frame_buffer_t;
+
+extern "C" {
+void send_data(uint8_t link, const uint8_t* data, uint16_t size) { SharedBusRouter::Instance->send_data(link, data, size); }
+
+void transport_recv_frame(uint8_t from, uint8_t* data, uint16_t size) { SharedBusRouter::Instance->transport_recv_frame(from, data, size); }
+}
+
+TEST_F(SharedBusRouter, master_broadcast_is_received_by_every_module) {
+    frame_buffer_t data;
+    data.data = {0xAB, 0x70, 0x55, 0xBB};
+    activate_node(0);
+    router_send_frame(0xFF, (uint8_t*)&data, 4);
+    EXPECT_GT(sent[0][DOWN_LINK].size(), 0);
+    EXPECT_EQ(sent[0][UP_LINK].size(), 0);
+
+    for (uint8_t module = 1; module < 4; module++) {
+        EXPECT_CALL(*this, transport_recv_frame(0, _, _)).With(Args<1, 2>(ElementsAreArray(data.data)));
+        simulate_bus(0, module);
+        // Nothing is forwarded, every module already heard it
+        EXPECT_EQ(sent[module][DOWN_LINK].size(), 0);
+        EXPECT_EQ(sent[module][UP_LINK].size(), 0);
+    }
+}
+
+TEST_F(SharedBusRouter, master_send_is_received_by_addressed_module_only) {
+    frame_buffer_t data;
+    data.data = {0xAB, 0x70, 0x55, 0xBB};
+    activate_node(0);
+    router_send_frame(2, (uint8_t*)&data, 4);
+
+    EXPECT_CALL(*this, transport_recv_frame(_, _, _)).Times(0);
+    simulate_bus(0, 1);
+    simulate_bus(0, 3);
+    testing::Mock::VerifyAndClearExpectations(this);
+
+    EXPECT_CALL(*this, transport_recv_frame(0, _, _)).With(Args<1, 2>(ElementsAreArray(data.data)));
+    simulate_bus(0, 2);
+}
+
+TEST_F(SharedBusRouter, module_sends_to_master_with_its_address) {
+    frame_buffer_t data;
+    data.data = {0xAB, 0x70, 0x55, 0xBB};
+    activate_node(3);
+    router_send_frame(0, (uint8_t*)&data, 4);
+    EXPECT_GT(sent[3][UP_LINK].size(), 0);
+    EXPECT_EQ(sent[3][DOWN_LINK].size(), 0);
+
+    EXPECT_CALL(*this, transport_recv_frame(3, _, _)).With(Args<1, 2>(ElementsAreArray(data.data)));
+    simulate_bus(3, 0);
+}
+
+TEST_F(SharedBusRouter, modules_ignore_each_other) {
+    frame_buffer_t data;
+    data.data = {0xAB, 0x70, 0x55, 0xBB};
+    activate_node(1);
+    router_send_frame(0, (uint8_t*)&data, 4);
+
+    EXPECT_CALL(*this, transport_recv_frame(_, _, _)).Times(0);
+    simulate_bus(1, 2);
+    simulate_bus(1, 3);
+    EXPECT_EQ(sent[2][UP_LINK].size(), 0);
+    EXPECT_EQ(sent[3][UP_LINK].size(), 0);
+}
+
+TEST_F(SharedBusRouter, master_ignores_its_own_frames) {
+    frame_buffer_t data;
+    data.data = {0xAB, 0x70, 0x55, 0xBB};
+    activate_node(0);
+    router_send_frame(1, (uint8_t*)&data, 4);
+
+    EXPECT_CALL(*this, transport_recv_frame(_, _, _)).Times(0);
+    simulate_bus(0, 0);
+}
+
+TEST_F(SharedBusRouter, module_sends_to_other_module_does_nothing) {
+    frame_buffer_t data;
+    data.data = {0xAB, 0x70, 0x55, 0xBB};
+    activate_node(1);
+    router_send_frame(2, (uint8_t*)&data, 4);
+    EXPECT_EQ(sent[1][UP_LINK].size(), 0);
+    EXPECT_EQ(sent[1][DOWN_LINK].size(), 0);
+}
@@ -2,5 +2,6 @@ TEST_LIST +=\
 	serial_link_byte_stuffer\
 	serial_link_frame_validator\
 	serial_link_frame_router\
+	serial_link_shared_bus_router\
 	serial_link_triple_buffered_object\
 	serial_link_transport
@@ -182,3 +182,31 @@ TEST_F(Transport, ignores_object_with_size_too_big) {
     test_object1* obj2 = read_master_to_slave();
     EXPECT_EQ(obj2, nullptr);
 }
+
+// serial_link polls module i, with the address i + 1, and reads its answer back at index i
+TEST_F(Transport, single_slave_objects_go_to_the_module_address) {
+    update_transport();
+    for (uint8_t i = 0; i < NUM_SLAVES; i++) {
+        begin_write_master_to_single_slave(i)->test = i;
+        EXPECT_CALL(*this, signal_data_written());
+        end_write_master_to_single_slave(i);
+        EXPECT_CALL(*this, router_send_frame(i + 1));
+        update_transport();
+    }
+}
+
+TEST_F(Transport, writes_from_last_slave_to_master) {
+    update_transport();
+    begin_write_slave_to_master()->test = 9;
+    EXPECT_CALL(*this, signal_data_written());
+    end_write_slave_to_master();
+    EXPECT_CALL(*this, router_send_frame(0));
+    update_transport();
+    transport_recv_frame(NUM_SLAVES, sent_data.data(), sent_data.size());
+    for (uint8_t i = 0; i < NUM_SLAVES - 1; i++) {
+        EXPECT_EQ(read_slave_to_master(i), nullptr);
+    }
+    test_object1* obj = read_slave_to_master(NUM_SLAVES - 1);
+    EXPECT_NE(obj, nullptr);
+    EXPECT_EQ(obj->test, 9);
+}
@@ -8,3 +8,7 @@
 #        define F_SCL 100000UL  // SCL frequency
 #    endif
 #endif
+
+#if defined(SPLIT_KEY_EVENT_TIMESTAMPS) && defined(DISABLE_SYNC_TIMER)
+#    error "SPLIT_KEY_EVENT_TIMESTAMPS requires the sync timer, remove DISABLE_SYNC_TIMER"
+#endif
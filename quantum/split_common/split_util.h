@@ -15,3 +15,7 @@ void split_post_init(void);
 
 bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 bool is_transport_connected(void);
+
+#ifdef SPLIT_KEY_EVENT_TIMESTAMPS
+uint16_t split_key_event_time(uint8_t row);
+#endif
@@ -24,6 +24,10 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_KEY_EVENT_TIMESTAMPS
+    GET_SLAVE_MATRIX_SCAN_TIME,
+#endif  // SPLIT_KEY_EVENT_TIMESTAMPS
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif  // SPLIT_TRANSPORT_MIRROR
@@ -64,6 +68,10 @@ enum serial_transaction_id {
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     PUT_RGB_MATRIX,
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    PUT_RGB_MATRIX_EVENTS,
+    PUT_RGB_MATRIX_FRAME,
+#    endif  // RGB_MATRIX_SPLIT_LOCKSTEP
 #endif  // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
@@ -32,6 +32,16 @@
 #    define FORCED_SYNC_THROTTLE_MS 100
 #endif  // FORCED_SYNC_THROTTLE_MS
 
+// Minimum interval between change-triggered sends of the lower-priority payloads (LED state, backlight, lighting, WPM, displays)
+#ifndef SPLIT_SYNC_DEFAULT_INTERVAL_MS
+#    define SPLIT_SYNC_DEFAULT_INTERVAL_MS 0
+#endif  // SPLIT_SYNC_DEFAULT_INTERVAL_MS
+
+// Maximum number of bytes the lower-priority payloads may send per scan, 0 for no limit
+#ifndef SPLIT_SYNC_BYTE_BUDGET
+#    define SPLIT_SYNC_BYTE_BUDGET 0
+#endif  // SPLIT_SYNC_BYTE_BUDGET
+
 #define sizeof_member(type, member) sizeof(((type *)NULL)->member)
 
 #define trans_initiator2target_initializer_cb(member, cb) \
@@ -75,6 +85,18 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         if (!transaction_handler_master(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master)) return false; \
     } while (0)
 
+inline static void transaction_handler_master_scheduled(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])) {
+    // Lower-priority payloads get a single attempt -- anything that failed is retried on a later scan instead of stalling this one
+    bool okay = true;
+    ATOMIC_BLOCK_FORCEON { okay = handler(master_matrix, slave_matrix); };
+    if (!okay) dprintf("Deferred %s\n", prefix);
+}
+
+#define TRANSACTION_HANDLER_MASTER_SCHEDULED(prefix)                                                           \
+    do {                                                                                                       \
+        transaction_handler_master_scheduled(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master); \
+    } while (0)
+
 #define TRANSACTION_HANDLER_SLAVE(prefix)                                               \
     do {                                                                                \
         ATOMIC_BLOCK_FORCEON { prefix##_handlers_slave(master_matrix, slave_matrix); }; \
@@ -106,6 +128,43 @@ inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, boo
     return okay;
 }
 
+static uint16_t sync_budget_used = 0;
+
+inline static bool sync_is_scheduled(uint32_t *last_update, uint16_t min_interval, bool condition, size_t length) {
+    uint32_t elapsed = timer_elapsed32(*last_update);
+    if (elapsed < FORCED_SYNC_THROTTLE_MS && (!condition || elapsed < min_interval)) {
+        return false;
+    }
+#if SPLIT_SYNC_BYTE_BUDGET > 0
+    // Always let the first payload of a scan through, so ones larger than the budget can't starve
+    if (sync_budget_used > 0 && sync_budget_used + length > SPLIT_SYNC_BYTE_BUDGET) {
+        return false;
+    }
+#endif  // SPLIT_SYNC_BYTE_BUDGET > 0
+    return true;
+}
+
+inline static bool sync_scheduled_write(int8_t trans_id, uint32_t *last_update, void *source, size_t length) {
+    bool okay = transport_write(trans_id, source, length);
+    if (okay) {
+        *last_update = timer_read32();
+        sync_budget_used += length;
+    }
+    return okay;
+}
+
+inline static bool send_if_scheduled(int8_t trans_id, uint32_t *last_update, uint16_t min_interval, bool condition, void *source, size_t length) {
+    if (!sync_is_scheduled(last_update, min_interval, condition, length)) {
+        // Nothing to do yet, or deferred to a later scan
+        return true;
+    }
+    return sync_scheduled_write(trans_id, last_update, source, length);
+}
+
+inline static bool send_if_data_mismatch_scheduled(int8_t trans_id, uint32_t *last_update, uint16_t min_interval, void *source, const void *equiv_shmem, size_t length) {
+    return send_if_scheduled(trans_id, last_update, min_interval, (memcmp(source, equiv_shmem, length) != 0), source, length);
+}
+
 inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update, void *source, const void *equiv_shmem, size_t length) {
     // Just run a memcmp to compare the source and equivalent shmem location
     return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
@@ -114,12 +173,22 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_KEY_EVENT_TIMESTAMPS
+static uint16_t slave_matrix_scan_time = 0;
+#endif  // SPLIT_KEY_EVENT_TIMESTAMPS
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0};  // last successfully-read matrix, so we can replicate if there are checksum errors
     matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];        // holding area while we test whether or not checksum is correct
 
     bool okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+#ifdef SPLIT_KEY_EVENT_TIMESTAMPS
+    if (okay && memcmp(last_matrix, temp_matrix, sizeof(temp_matrix)) != 0) {
+        // Only fetch the scan time when the matrix actually changed
+        okay &= transport_read(GET_SLAVE_MATRIX_SCAN_TIME, &slave_matrix_scan_time, sizeof(slave_matrix_scan_time));
+    }
+#endif  // SPLIT_KEY_EVENT_TIMESTAMPS
     if (okay) {
         // Checksum matches the received data, save as the last matrix state
         memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
@@ -130,16 +199,37 @@ static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_ro
 }
 
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_KEY_EVENT_TIMESTAMPS
+    if (memcmp(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix)) != 0) {
+        // Record when this scan saw the change, in master-aligned time
+        split_shmem->smatrix.scan_time = sync_timer_read();
+    }
+#endif  // SPLIT_KEY_EVENT_TIMESTAMPS
     memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
     split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
 }
 
+#ifdef SPLIT_KEY_EVENT_TIMESTAMPS
+uint16_t split_key_event_time(uint8_t row) {
+    bool slave_row = isLeftHand ? (row >= (MATRIX_ROWS) / 2) : (row < (MATRIX_ROWS) / 2);
+    if (!is_keyboard_master() || !slave_row) {
+        return timer_read();
+    }
+    return slave_matrix_scan_time;
+}
+
+#    define TRANSACTIONS_SLAVE_MATRIX_SCAN_TIME_REGISTRATIONS [GET_SLAVE_MATRIX_SCAN_TIME] = trans_target2initiator_initializer(smatrix.scan_time),
+#else  // SPLIT_KEY_EVENT_TIMESTAMPS
+#    define TRANSACTIONS_SLAVE_MATRIX_SCAN_TIME_REGISTRATIONS
+#endif  // SPLIT_KEY_EVENT_TIMESTAMPS
+
 // clang-format off
 #define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
-    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix), \
+    TRANSACTIONS_SLAVE_MATRIX_SCAN_TIME_REGISTRATIONS
 // clang-format on
 
 ////////////////////////////////////////////////////
@@ -289,10 +379,14 @@ static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #ifdef SPLIT_LED_STATE_ENABLE
 
+#    ifndef SPLIT_LED_STATE_SYNC_INTERVAL_MS
+#        define SPLIT_LED_STATE_SYNC_INTERVAL_MS SPLIT_SYNC_DEFAULT_INTERVAL_MS
+#    endif  // SPLIT_LED_STATE_SYNC_INTERVAL_MS
+
 static bool led_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
     uint8_t         led_state   = host_keyboard_leds();
-    return send_if_data_mismatch(PUT_LED_STATE, &last_update, &led_state, &split_shmem->led_state, sizeof(led_state));
+    return send_if_data_mismatch_scheduled(PUT_LED_STATE, &last_update, SPLIT_LED_STATE_SYNC_INTERVAL_MS, &led_state, &split_shmem->led_state, sizeof(led_state));
 }
 
 static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -300,7 +394,7 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     set_split_host_keyboard_leds(split_shmem->led_state);
 }
 
-#    define TRANSACTIONS_LED_STATE_MASTER()      TRANSACTION_HANDLER_MASTER(led_state)
+#    define TRANSACTIONS_LED_STATE_MASTER()      TRANSACTION_HANDLER_MASTER_SCHEDULED(led_state)
 #    define TRANSACTIONS_LED_STATE_SLAVE()       TRANSACTION_HANDLER_SLAVE(led_state)
 #    define TRANSACTIONS_LED_STATE_REGISTRATIONS [PUT_LED_STATE] = trans_initiator2target_initializer(led_state),
 
@@ -374,15 +468,19 @@ static void mods_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 
 #ifdef BACKLIGHT_ENABLE
 
+#    ifndef SPLIT_BACKLIGHT_SYNC_INTERVAL_MS
+#        define SPLIT_BACKLIGHT_SYNC_INTERVAL_MS SPLIT_SYNC_DEFAULT_INTERVAL_MS
+#    endif  // SPLIT_BACKLIGHT_SYNC_INTERVAL_MS
+
 static bool backlight_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
     uint8_t         level       = is_backlight_enabled() ? get_backlight_level() : 0;
-    return send_if_condition(PUT_BACKLIGHT, &last_update, (level != split_shmem->backlight_level), &level, sizeof(level));
+    return send_if_scheduled(PUT_BACKLIGHT, &last_update, SPLIT_BACKLIGHT_SYNC_INTERVAL_MS, (level != split_shmem->backlight_level), &level, sizeof(level));
 }
 
 static void backlight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) { backlight_set(split_shmem->backlight_level); }
 
-#    define TRANSACTIONS_BACKLIGHT_MASTER()      TRANSACTION_HANDLER_MASTER(backlight)
+#    define TRANSACTIONS_BACKLIGHT_MASTER()      TRANSACTION_HANDLER_MASTER_SCHEDULED(backlight)
 #    define TRANSACTIONS_BACKLIGHT_SLAVE()       TRANSACTION_HANDLER_SLAVE(backlight)
 #    define TRANSACTIONS_BACKLIGHT_REGISTRATIONS [PUT_BACKLIGHT] = trans_initiator2target_initializer(backlight_level),
 
@@ -399,11 +497,19 @@ static void backlight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
 
+#    ifndef SPLIT_RGBLIGHT_SYNC_INTERVAL_MS
+#        define SPLIT_RGBLIGHT_SYNC_INTERVAL_MS SPLIT_SYNC_DEFAULT_INTERVAL_MS
+#    endif  // SPLIT_RGBLIGHT_SYNC_INTERVAL_MS
+
 static bool rgblight_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update = 0;
     rgblight_syncinfo_t rgblight_sync;
     rgblight_get_syncinfo(&rgblight_sync);
-    if (send_if_condition(PUT_RGBLIGHT, &last_update, (rgblight_sync.status.change_flags != 0), &rgblight_sync, sizeof(rgblight_sync))) {
+    if (!sync_is_scheduled(&last_update, SPLIT_RGBLIGHT_SYNC_INTERVAL_MS, (rgblight_sync.status.change_flags != 0), sizeof(rgblight_sync))) {
+        // Keep the change flags pending until they've actually been sent
+        return true;
+    }
+    if (sync_scheduled_write(PUT_RGBLIGHT, &last_update, &rgblight_sync, sizeof(rgblight_sync))) {
         rgblight_clear_change_flags();
     } else {
         return false;
@@ -419,7 +525,7 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     }
 }
 
-#    define TRANSACTIONS_RGBLIGHT_MASTER()      TRANSACTION_HANDLER_MASTER(rgblight)
+#    define TRANSACTIONS_RGBLIGHT_MASTER()      TRANSACTION_HANDLER_MASTER_SCHEDULED(rgblight)
 #    define TRANSACTIONS_RGBLIGHT_SLAVE()       TRANSACTION_HANDLER_SLAVE(rgblight)
 #    define TRANSACTIONS_RGBLIGHT_REGISTRATIONS [PUT_RGBLIGHT] = trans_initiator2target_initializer(rgblight_sync),
 
@@ -436,12 +542,16 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 
 #if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
+#    ifndef SPLIT_LED_MATRIX_SYNC_INTERVAL_MS
+#        define SPLIT_LED_MATRIX_SYNC_INTERVAL_MS SPLIT_SYNC_DEFAULT_INTERVAL_MS
+#    endif  // SPLIT_LED_MATRIX_SYNC_INTERVAL_MS
+
 static bool led_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update = 0;
     led_matrix_sync_t led_matrix_sync;
     memcpy(&led_matrix_sync.led_matrix, &led_matrix_eeconfig, sizeof(led_eeconfig_t));
     led_matrix_sync.led_suspend_state = led_matrix_get_suspend_state();
-    return send_if_data_mismatch(PUT_LED_MATRIX, &last_update, &led_matrix_sync, &split_shmem->led_matrix_sync, sizeof(led_matrix_sync));
+    return send_if_data_mismatch_scheduled(PUT_LED_MATRIX, &last_update, SPLIT_LED_MATRIX_SYNC_INTERVAL_MS, &led_matrix_sync, &split_shmem->led_matrix_sync, sizeof(led_matrix_sync));
 }
 
 static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -449,7 +559,7 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     led_matrix_set_suspend_state(split_shmem->led_matrix_sync.led_suspend_state);
 }
 
-#    define TRANSACTIONS_LED_MATRIX_MASTER()      TRANSACTION_HANDLER_MASTER(led_matrix)
+#    define TRANSACTIONS_LED_MATRIX_MASTER()      TRANSACTION_HANDLER_MASTER_SCHEDULED(led_matrix)
 #    define TRANSACTIONS_LED_MATRIX_SLAVE()       TRANSACTION_HANDLER_SLAVE(led_matrix)
 #    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer(led_matrix_sync),
 
@@ -466,22 +576,52 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
+#    ifndef SPLIT_RGB_MATRIX_SYNC_INTERVAL_MS
+#        define SPLIT_RGB_MATRIX_SYNC_INTERVAL_MS SPLIT_SYNC_DEFAULT_INTERVAL_MS
+#    endif  // SPLIT_RGB_MATRIX_SYNC_INTERVAL_MS
+
 static bool rgb_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update = 0;
     rgb_matrix_sync_t rgb_matrix_sync;
     memcpy(&rgb_matrix_sync.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
     rgb_matrix_sync.rgb_suspend_state = rgb_matrix_get_suspend_state();
-    return send_if_data_mismatch(PUT_RGB_MATRIX, &last_update, &rgb_matrix_sync, &split_shmem->rgb_matrix_sync, sizeof(rgb_matrix_sync));
+    bool okay = send_if_data_mismatch_scheduled(PUT_RGB_MATRIX, &last_update, SPLIT_RGB_MATRIX_SYNC_INTERVAL_MS, &rgb_matrix_sync, &split_shmem->rgb_matrix_sync, sizeof(rgb_matrix_sync));
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    // Key events go first, so the slave has them before it renders the frame that uses them.
+    // Both are outside the byte budget, a deferred frame would stall the slave's rendering.
+    static uint32_t last_events_update = 0;
+    static uint32_t last_frame_update  = 0;
+    if (okay) {
+        okay &= send_if_data_mismatch(PUT_RGB_MATRIX_EVENTS, &last_events_update, (void *)rgb_matrix_get_lockstep_events(), &split_shmem->rgb_matrix_events, sizeof(rgb_lockstep_events_t));
+    }
+    if (okay) {
+        okay &= send_if_data_mismatch(PUT_RGB_MATRIX_FRAME, &last_frame_update, (void *)rgb_matrix_get_lockstep_frame(), &split_shmem->rgb_matrix_frame, sizeof(rgb_lockstep_frame_t));
+    }
+#    endif  // RGB_MATRIX_SPLIT_LOCKSTEP
+    return okay;
 }
 
 static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     memcpy(&rgb_matrix_config, &split_shmem->rgb_matrix_sync.rgb_matrix, sizeof(rgb_config_t));
     rgb_matrix_set_suspend_state(split_shmem->rgb_matrix_sync.rgb_suspend_state);
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    rgb_matrix_update_lockstep_events(&split_shmem->rgb_matrix_events);
+    rgb_matrix_update_lockstep_frame(&split_shmem->rgb_matrix_frame);
+#    endif  // RGB_MATRIX_SPLIT_LOCKSTEP
 }
 
-#    define TRANSACTIONS_RGB_MATRIX_MASTER()      TRANSACTION_HANDLER_MASTER(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_SLAVE()       TRANSACTION_HANDLER_SLAVE(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+// clang-format off
+#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rgb_matrix)
+#    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+#        define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS \
+    [PUT_RGB_MATRIX]        = trans_initiator2target_initializer(rgb_matrix_sync), \
+    [PUT_RGB_MATRIX_EVENTS] = trans_initiator2target_initializer(rgb_matrix_events), \
+    [PUT_RGB_MATRIX_FRAME]  = trans_initiator2target_initializer(rgb_matrix_frame),
+#    else
+#        define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+#    endif  // RGB_MATRIX_SPLIT_LOCKSTEP
+// clang-format on
 
 #else  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
@@ -496,15 +636,19 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
+#    ifndef SPLIT_WPM_SYNC_INTERVAL_MS
+#        define SPLIT_WPM_SYNC_INTERVAL_MS SPLIT_SYNC_DEFAULT_INTERVAL_MS
+#    endif  // SPLIT_WPM_SYNC_INTERVAL_MS
+
 static bool wpm_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
     uint8_t         current_wpm = get_current_wpm();
-    return send_if_condition(PUT_WPM, &last_update, (current_wpm != split_shmem->current_wpm), &current_wpm, sizeof(current_wpm));
+    return send_if_scheduled(PUT_WPM, &last_update, SPLIT_WPM_SYNC_INTERVAL_MS, (current_wpm != split_shmem->current_wpm), &current_wpm, sizeof(current_wpm));
 }
 
 static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) { set_current_wpm(split_shmem->current_wpm); }
 
-#    define TRANSACTIONS_WPM_MASTER()      TRANSACTION_HANDLER_MASTER(wpm)
+#    define TRANSACTIONS_WPM_MASTER()      TRANSACTION_HANDLER_MASTER_SCHEDULED(wpm)
 #    define TRANSACTIONS_WPM_SLAVE()       TRANSACTION_HANDLER_SLAVE(wpm)
 #    define TRANSACTIONS_WPM_REGISTRATIONS [PUT_WPM] = trans_initiator2target_initializer(current_wpm),
 
@@ -521,10 +665,14 @@ static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_
 
 #if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
+#    ifndef SPLIT_OLED_SYNC_INTERVAL_MS
+#        define SPLIT_OLED_SYNC_INTERVAL_MS SPLIT_SYNC_DEFAULT_INTERVAL_MS
+#    endif  // SPLIT_OLED_SYNC_INTERVAL_MS
+
 static bool oled_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update        = 0;
     bool            current_oled_state = is_oled_on();
-    return send_if_condition(PUT_OLED, &last_update, (current_oled_state != split_shmem->current_oled_state), &current_oled_state, sizeof(current_oled_state));
+    return send_if_scheduled(PUT_OLED, &last_update, SPLIT_OLED_SYNC_INTERVAL_MS, (current_oled_state != split_shmem->current_oled_state), &current_oled_state, sizeof(current_oled_state));
 }
 
 static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -535,7 +683,7 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
     }
 }
 
-#    define TRANSACTIONS_OLED_MASTER()      TRANSACTION_HANDLER_MASTER(oled)
+#    define TRANSACTIONS_OLED_MASTER()      TRANSACTION_HANDLER_MASTER_SCHEDULED(oled)
 #    define TRANSACTIONS_OLED_SLAVE()       TRANSACTION_HANDLER_SLAVE(oled)
 #    define TRANSACTIONS_OLED_REGISTRATIONS [PUT_OLED] = trans_initiator2target_initializer(current_oled_state),
 
@@ -552,10 +700,14 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 
 #if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
 
+#    ifndef SPLIT_ST7565_SYNC_INTERVAL_MS
+#        define SPLIT_ST7565_SYNC_INTERVAL_MS SPLIT_SYNC_DEFAULT_INTERVAL_MS
+#    endif  // SPLIT_ST7565_SYNC_INTERVAL_MS
+
 static bool st7565_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update          = 0;
     bool            current_st7565_state = st7565_is_on();
-    return send_if_condition(PUT_ST7565, &last_update, (current_st7565_state != split_shmem->current_st7565_state), &current_st7565_state, sizeof(current_st7565_state));
+    return send_if_scheduled(PUT_ST7565, &last_update, SPLIT_ST7565_SYNC_INTERVAL_MS, (current_st7565_state != split_shmem->current_st7565_state), &current_st7565_state, sizeof(current_st7565_state));
 }
 
 static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -566,7 +718,7 @@ static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
     }
 }
 
-#    define TRANSACTIONS_ST7565_MASTER()      TRANSACTION_HANDLER_MASTER(st7565)
+#    define TRANSACTIONS_ST7565_MASTER()      TRANSACTION_HANDLER_MASTER_SCHEDULED(st7565)
 #    define TRANSACTIONS_ST7565_SLAVE()       TRANSACTION_HANDLER_SLAVE(st7565)
 #    define TRANSACTIONS_ST7565_REGISTRATIONS [PUT_ST7565] = trans_initiator2target_initializer(current_st7565_state),
 
@@ -615,13 +767,17 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Key delivery first -- any failure here aborts the scan so the connection state is tracked correctly
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
+    TRANSACTIONS_MODS_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
     TRANSACTIONS_SYNC_TIMER_MASTER();
     TRANSACTIONS_LAYER_STATE_MASTER();
+
+    // Lower-priority payloads, in priority order, sharing the per-scan byte budget
+    sync_budget_used = 0;
     TRANSACTIONS_LED_STATE_MASTER();
-    TRANSACTIONS_MODS_MASTER();
     TRANSACTIONS_BACKLIGHT_MASTER();
     TRANSACTIONS_RGBLIGHT_MASTER();
     TRANSACTIONS_LED_MATRIX_MASTER();
@@ -15,6 +15,7 @@
  */
 
 #include <string.h>
+#include <stddef.h>
 #include <debug.h>
 
 #include "transactions.h"
@@ -55,9 +56,116 @@ i2c_status_t transport_trigger_callback(int8_t id) {
     return i2c_writeReg(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, SLAVE_I2C_TIMEOUT);
 }
 
+#    ifdef SPLIT_I2C_BULK_TRANSFER
+
+// Byte gap below which two dirty spans are sent as one write, as re-addressing costs more than resending a few bytes
+#        ifndef SPLIT_I2C_BULK_MERGE_GAP
+#            define SPLIT_I2C_BULK_MERGE_GAP 4
+#        endif  // SPLIT_I2C_BULK_MERGE_GAP
+
+// Slave-to-master sync data, fetched in one transfer at the start of each scan
+#        define BULK_READ_WINDOW_START offsetof(split_shared_memory_t, smatrix)
+#        ifdef ENCODER_ENABLE
+#            define BULK_READ_WINDOW_END (offsetof(split_shared_memory_t, encoders) + sizeof(split_slave_encoder_sync_t))
+#        else
+#            define BULK_READ_WINDOW_END (offsetof(split_shared_memory_t, smatrix) + sizeof(split_slave_matrix_sync_t))
+#        endif
+
+static uint8_t bulk_dirty[(sizeof(split_shared_memory_t) + 7) / 8];
+
+static void bulk_mark_dirty(uint16_t offset, uint16_t length) {
+    for (uint16_t i = offset; i < offset + length; ++i) {
+        bulk_dirty[i / 8] |= 1 << (i % 8);
+    }
+}
+
+static bool bulk_is_dirty(uint16_t offset) { return bulk_dirty[offset / 8] & (1 << (offset % 8)); }
+
+static bool bulk_read_window(void) {
+    uint8_t window[BULK_READ_WINDOW_END - BULK_READ_WINDOW_START];
+    if (i2c_readReg(SLAVE_I2C_ADDRESS, BULK_READ_WINDOW_START, window, sizeof(window), SLAVE_I2C_TIMEOUT) < 0) {
+        return false;
+    }
+
+    // With SPLIT_TRANSPORT_MIRROR the master matrix lies inside the window, bytes still waiting to be flushed must not be replaced by the slave's older copy
+    uint8_t *shmem = split_shmem_offset_ptr(BULK_READ_WINDOW_START);
+    for (uint16_t i = 0; i < sizeof(window); ++i) {
+        if (!bulk_is_dirty(BULK_READ_WINDOW_START + i)) {
+            shmem[i] = window[i];
+        }
+    }
+    return true;
+}
+
+static bool bulk_flush_dirty(void) {
+    uint16_t offset = 0;
+    while (offset < sizeof(split_shared_memory_t)) {
+        if (!bulk_is_dirty(offset)) {
+            ++offset;
+            continue;
+        }
+
+        // Extend the span over any clean gaps small enough to be cheaper to resend than to re-address
+        uint16_t start = offset;
+        uint16_t end   = offset + 1;
+        for (uint16_t probe = end; probe < sizeof(split_shared_memory_t) && probe < end + SPLIT_I2C_BULK_MERGE_GAP; ++probe) {
+            if (bulk_is_dirty(probe)) {
+                end = probe + 1;
+            }
+        }
+
+        if (i2c_writeReg(SLAVE_I2C_ADDRESS, start, split_shmem_offset_ptr(start), end - start, SLAVE_I2C_TIMEOUT) < 0) {
+            // Leave the remaining spans dirty so they're retried on the next scan
+            return false;
+        }
+        for (uint16_t i = start; i < end; ++i) {
+            bulk_dirty[i / 8] &= ~(1 << (i % 8));
+        }
+        offset = end;
+    }
+    return true;
+}
+
+static bool bulk_window_contains(uint16_t offset, uint16_t length) { return offset >= BULK_READ_WINDOW_START && offset + length <= BULK_READ_WINDOW_END; }
+
+// Writes the slave has to see as soon as they are made, rather than at the end of the scan
+static bool bulk_write_immediately(int8_t id) {
+#        ifndef DISABLE_SYNC_TIMER
+    // The timer value is offset for the transfer delay, holding it back for the rest of the scan would leave the slave behind
+    return id == PUT_SYNC_TIMER;
+#        else
+    return false;
+#        endif  // DISABLE_SYNC_TIMER
+}
+
+#    endif  // SPLIT_I2C_BULK_TRANSFER
+
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     i2c_status_t              status;
     split_transaction_desc_t *trans = &split_transaction_table[id];
+#    ifdef SPLIT_I2C_BULK_TRANSFER
+    if (!trans->slave_callback && !bulk_write_immediately(id)) {
+        // Plain data -- writes are batched until the end of the scan, reads come from the window fetched at its start
+        if (initiator2target_length > 0) {
+            size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+            memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+            bulk_mark_dirty(trans->initiator2target_offset, len);
+        }
+        if (target2initiator_length > 0) {
+            size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+            if (!bulk_window_contains(trans->target2initiator_offset, len) && i2c_readReg(SLAVE_I2C_ADDRESS, trans->target2initiator_offset, split_trans_target2initiator_buffer(trans), len, SLAVE_I2C_TIMEOUT) < 0) {
+                return false;
+            }
+            memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+        }
+        return true;
+    }
+
+    // The callback has to see everything written so far
+    if (trans->slave_callback && !bulk_flush_dirty()) {
+        return false;
+    }
+#    endif  // SPLIT_I2C_BULK_TRANSFER
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
         memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
@@ -113,6 +221,18 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 
 #endif  // USE_I2C
 
+#if defined(USE_I2C) && defined(SPLIT_I2C_BULK_TRANSFER)
+bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    bool okay = bulk_read_window();
+    // Run the transactions even if the fetch failed, so the last-known-good slave state is still handed back
+    okay &= transactions_master(master_matrix, slave_matrix);
+    if (okay) {
+        okay = bulk_flush_dirty();
+    }
+    return okay;
+}
+#else
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) { return transactions_master(master_matrix, slave_matrix); }
+#endif
 
 void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) { transactions_slave(master_matrix, slave_matrix); }
@@ -56,6 +56,9 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 typedef struct _split_slave_matrix_sync_t {
     uint8_t      checksum;
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
+#ifdef SPLIT_KEY_EVENT_TIMESTAMPS
+    uint16_t scan_time;
+#endif  // SPLIT_KEY_EVENT_TIMESTAMPS
 } split_slave_matrix_sync_t;
 
 #ifdef SPLIT_TRANSPORT_MIRROR
@@ -159,6 +162,10 @@ typedef struct _split_shared_memory_t {
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     rgb_matrix_sync_t rgb_matrix_sync;
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    rgb_lockstep_events_t rgb_matrix_events;
+    rgb_lockstep_frame_t  rgb_matrix_frame;
+#    endif  // RGB_MATRIX_SPLIT_LOCKSTEP
 #endif  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
@@ -0,0 +1,34 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// The synthetic board is a grid with one LED per key, pass e.g.
+// EXTRAFLAGS="-DRGB_MATRIX_TEST_ROWS=4 -DRGB_MATRIX_TEST_COLS=12" to compare other LED counts
+#ifndef RGB_MATRIX_TEST_ROWS
+#    define RGB_MATRIX_TEST_ROWS 6
+#endif
+#ifndef RGB_MATRIX_TEST_COLS
+#    define RGB_MATRIX_TEST_COLS 16
+#endif
+
+#define MATRIX_ROWS RGB_MATRIX_TEST_ROWS
+#define MATRIX_COLS RGB_MATRIX_TEST_COLS
+#define DRIVER_LED_TOTAL (MATRIX_ROWS * MATRIX_COLS)
+
+// Build every effect, including the reactive and framebuffer ones
+#define RGB_MATRIX_KEYPRESSES
+#define RGB_MATRIX_FRAMEBUFFER_EFFECTS
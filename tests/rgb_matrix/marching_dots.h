@@ -0,0 +1,27 @@
+#pragma once
+
+// clang-format off
+
+// Generated by `qmk generate-keyframes` from marching_dots.json
+// 16 LEDs, 8 frames of 50ms, 2 colors
+// 71 bytes of frames, 384 uncompressed
+
+static const uint8_t PROGMEM marching_dots_keyframes_palette[] = {
+    0xFF, 0x40, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t PROGMEM marching_dots_keyframes_stream[] = {
+    0x80, 0x00, 0xC6, 0x01, 0x80, 0x00, 0xC6, 0x01, 0x00, 0x81, 0x01, 0x00, 0x06, 0x81, 0x01, 0x00,
+    0x00, 0x01, 0x81, 0x01, 0x00, 0x06, 0x81, 0x01, 0x00, 0x00, 0x02, 0x81, 0x01, 0x00, 0x06, 0x81,
+    0x01, 0x00, 0x00, 0x03, 0x81, 0x01, 0x00, 0x06, 0x81, 0x01, 0x00, 0x00, 0x04, 0x81, 0x01, 0x00,
+    0x06, 0x81, 0x01, 0x00, 0x00, 0x05, 0x81, 0x01, 0x00, 0x06, 0x81, 0x01, 0x00, 0x00, 0x06, 0x81,
+    0x01, 0x00, 0x06, 0x81, 0x01, 0x00, 0x00,
+};
+
+static const rgb_matrix_keyframes_t marching_dots_keyframes = {
+    .palette   = marching_dots_keyframes_palette,
+    .stream    = marching_dots_keyframes_stream,
+    .frames    = 8,
+    .frame_ms  = 50,
+    .led_count = 16,
+};
@@ -0,0 +1,84 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "rgb_matrix.h"
+#include "rgb_matrix_mock.h"
+#include "lib/lib8tion/lib8tion.h"
+
+led_config_t g_led_config;
+
+RGB      rgb_matrix_mock_buffer[DRIVER_LED_TOTAL];
+RGB      rgb_matrix_mock_frame[DRIVER_LED_TOTAL];
+uint32_t rgb_matrix_mock_flushes;
+uint32_t rgb_matrix_mock_bad_writes;
+
+// Lays the LEDs out as an evenly spaced grid over the whole 224x64 effect area, with the outer columns as modifiers
+static void init(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led                      = row * MATRIX_COLS + col;
+            g_led_config.matrix_co[row][col] = led;
+            g_led_config.point[led].x        = MATRIX_COLS > 1 ? col * 224 / (MATRIX_COLS - 1) : 112;
+            g_led_config.point[led].y        = MATRIX_ROWS > 1 ? row * 64 / (MATRIX_ROWS - 1) : 32;
+            g_led_config.flags[led]          = (col == 0 || col == MATRIX_COLS - 1) ? LED_FLAG_MODIFIER : LED_FLAG_KEYLIGHT;
+        }
+    }
+}
+
+static void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index < 0 || index >= DRIVER_LED_TOTAL) {
+        rgb_matrix_mock_bad_writes++;
+        return;
+    }
+    rgb_matrix_mock_buffer[index] = (RGB){.r = r, .g = g, .b = b};
+}
+
+static void set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
+        set_color(i, r, g, b);
+    }
+}
+
+static void flush(void) {
+    memcpy(rgb_matrix_mock_frame, rgb_matrix_mock_buffer, sizeof(rgb_matrix_mock_frame));
+    rgb_matrix_mock_flushes++;
+}
+
+// Random driver for the effects, reseeded along with rand() so every effect renders the same drops on every run
+void random_driver_init(void) {}
+
+void random_driver_fill(void *data, size_t size) {
+    uint8_t *bytes = data;
+    while (size--) *bytes++ = rand();
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = init,
+    .set_color     = set_color,
+    .set_color_all = set_color_all,
+    .flush         = flush,
+};
+
+void rgb_matrix_mock_reset(uint16_t seed) {
+    memset(rgb_matrix_mock_buffer, 0, sizeof(rgb_matrix_mock_buffer));
+    memset(rgb_matrix_mock_frame, 0, sizeof(rgb_matrix_mock_frame));
+    rgb_matrix_mock_flushes    = 0;
+    rgb_matrix_mock_bad_writes = 0;
+    random16_set_seed(seed);
+    srand(seed);
+}
@@ -0,0 +1,31 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "color.h"
+
+// The colors written by set_color since the last flush
+extern RGB rgb_matrix_mock_buffer[DRIVER_LED_TOTAL];
+// The colors the last flush sent to the "hardware"
+extern RGB rgb_matrix_mock_frame[DRIVER_LED_TOTAL];
+extern uint32_t rgb_matrix_mock_flushes;
+// Number of set_color calls with an index outside of the board
+extern uint32_t rgb_matrix_mock_bad_writes;
+
+// Clears the buffers and counters and reseeds both random number generators the effects use
+void rgb_matrix_mock_reset(uint16_t seed);
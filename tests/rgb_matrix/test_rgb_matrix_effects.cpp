@@ -0,0 +1,304 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "rgb_matrix_mock.h"
+#include "rgb_current.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+// Frames rendered per effect, each one becomes a column of the image strip
+#ifndef RGB_MATRIX_TEST_FRAMES
+#    define RGB_MATRIX_TEST_FRAMES 64
+#endif
+
+// Pixels per LED side in the dumped image strips
+#define RGB_MATRIX_TEST_SCALE 4
+
+// Upper bound of task runs per frame, a frame taking longer than this never finished
+#define RGB_MATRIX_TEST_MAX_TASKS 1000
+
+// A frame scaled down to the current budget has fractional levels, which dithering spreads over neighbouring LEDs
+#if defined(RGB_MATRIX_DITHER) && defined(RGB_CURRENT_BUDGET_MA)
+#    define RGB_MATRIX_TEST_LEVEL_SLACK 1
+#else
+#    define RGB_MATRIX_TEST_LEVEL_SLACK 0
+#endif
+
+struct Effect {
+    uint8_t     mode;
+    const char* name;
+};
+
+static const Effect effects[] = {
+#define RGB_MATRIX_EFFECT(name, ...) {RGB_MATRIX_##name, #name},
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+};
+
+// The checksums below were recorded on the default board, other configurations only check the invariants
+#if RGB_MATRIX_TEST_ROWS == 6 && RGB_MATRIX_TEST_COLS == 16 && RGB_MATRIX_TEST_FRAMES == 64 && !defined(RGB_MATRIX_GOVERNOR) && !defined(RGB_MATRIX_DITHER) && !defined(RGB_CURRENT_BUDGET_MA)
+#    define RGB_MATRIX_TEST_GOLDEN
+#endif
+
+#ifdef RGB_MATRIX_TEST_GOLDEN
+struct Golden {
+    const char* name;
+    uint32_t    checksum;
+};
+
+// When an effect is meant to look different, check its image strip and update its checksum here
+static const Golden goldens[] = {
+    {"SOLID_COLOR", 0x876cb5c5},
+    {"ALPHAS_MODS", 0x8b75d3c5},
+    {"GRADIENT_UP_DOWN", 0xb1f13dc5},
+    {"GRADIENT_LEFT_RIGHT", 0xf81e12c5},
+    {"BREATHING", 0xebcd28e5},
+    {"BAND_SAT", 0x97eb9861},
+    {"BAND_VAL", 0xf1e0df7d},
+    {"BAND_PINWHEEL_SAT", 0x469bae95},
+    {"BAND_PINWHEEL_VAL", 0x7dad7648},
+    {"BAND_SPIRAL_SAT", 0xa01b5965},
+    {"BAND_SPIRAL_VAL", 0xe458741e},
+    {"CYCLE_ALL", 0xe1ad0545},
+    {"CYCLE_LEFT_RIGHT", 0xd75122cd},
+    {"CYCLE_UP_DOWN", 0x92446c65},
+    {"RAINBOW_MOVING_CHEVRON", 0x7c4c1eef},
+    {"CYCLE_OUT_IN", 0x5d5d6cc1},
+    {"CYCLE_OUT_IN_DUAL", 0xb2e2c5a5},
+    {"CYCLE_PINWHEEL", 0x90698e33},
+    {"CYCLE_SPIRAL", 0x243a8a03},
+    {"DUAL_BEACON", 0x2c2c10bb},
+    {"RAINBOW_BEACON", 0x9a5fc869},
+    {"RAINBOW_PINWHEELS", 0x76a086b7},
+    {"RAINDROPS", 0x4733a7af},
+    {"JELLYBEAN_RAINDROPS", 0x0b45c096},
+    {"HUE_BREATHING", 0x7b6bd545},
+    {"HUE_PENDULUM", 0x0271bb7d},
+    {"HUE_WAVE", 0x2744935d},
+    {"TYPING_HEATMAP", 0x9342c50f},
+    {"DIGITAL_RAIN", 0x621f0ec5},
+    {"SOLID_REACTIVE_SIMPLE", 0xfc2c8891},
+    {"SOLID_REACTIVE", 0x9d1db72b},
+    {"SOLID_REACTIVE_WIDE", 0x974c44a0},
+    {"SOLID_REACTIVE_MULTIWIDE", 0x38fa1048},
+    {"SOLID_REACTIVE_CROSS", 0x0b9b819e},
+    {"SOLID_REACTIVE_MULTICROSS", 0x2c0ab8ca},
+    {"SOLID_REACTIVE_NEXUS", 0xd9e8567a},
+    {"SOLID_REACTIVE_MULTINEXUS", 0x0edf8df6},
+    {"SPLASH", 0x21de355a},
+    {"MULTISPLASH", 0x3f527f6c},
+    {"SOLID_SPLASH", 0x37d376e6},
+    {"SOLID_MULTISPLASH", 0x0de98685},
+};
+
+static const Golden* find_golden(const char* name) {
+    for (const Golden& golden : goldens) {
+        if (strcmp(golden.name, name) == 0) return &golden;
+    }
+    return nullptr;
+}
+#endif
+
+struct Rendering {
+    std::vector<RGB> frames;
+    uint64_t         nanoseconds = 0;
+    uint32_t         tasks       = 0;
+};
+
+class RgbMatrixEffects : public TestFixture {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(HSV_RED);
+        rgb_matrix_set_speed_noeeprom(UINT8_MAX / 2);
+    }
+
+    // Runs the task until the effect has been flushed the given number of times, timing only the task itself
+    Rendering render(uint8_t mode, uint16_t frames) {
+        Rendering rendering;
+        rgb_matrix_mode_noeeprom(mode);
+        rgb_matrix_mock_reset(1337);
+
+        for (uint16_t frame = 0; frame < frames; frame++) {
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+            // A few hits so the reactive effects have something to show
+            if (frame % 16 == 0) {
+                uint8_t key = frame / 16;
+                process_rgb_matrix((key * 2) % MATRIX_ROWS, (key * 5) % MATRIX_COLS, true);
+            }
+#endif
+            uint32_t flushes = rgb_matrix_mock_flushes;
+            uint32_t tasks   = 0;
+            while (rgb_matrix_mock_flushes == flushes && tasks < RGB_MATRIX_TEST_MAX_TASKS) {
+                auto start = std::chrono::steady_clock::now();
+                rgb_matrix_task();
+                rendering.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                tasks++;
+                advance_time(1);
+            }
+            rendering.tasks += tasks;
+            rendering.frames.insert(rendering.frames.end(), rgb_matrix_mock_frame, rgb_matrix_mock_frame + DRIVER_LED_TOTAL);
+        }
+        return rendering;
+    }
+
+    // Writes the frames side by side as a binary PPM, each one laid out like the synthetic board
+    static void dump_strip(const char* dir, const char* name, const Rendering& rendering) {
+        uint16_t frames = rendering.frames.size() / DRIVER_LED_TOTAL;
+        uint32_t width  = frames * (MATRIX_COLS + 1) * RGB_MATRIX_TEST_SCALE;
+        uint32_t height = MATRIX_ROWS * RGB_MATRIX_TEST_SCALE;
+
+        std::string path = std::string(dir) + "/" + name + ".ppm";
+        FILE*       file = fopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr) << "could not open " << path;
+        fprintf(file, "P6\n%u %u\n255\n", width, height);
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+                uint16_t frame = x / ((MATRIX_COLS + 1) * RGB_MATRIX_TEST_SCALE);
+                uint8_t  col   = x / RGB_MATRIX_TEST_SCALE % (MATRIX_COLS + 1);
+                uint8_t  row   = y / RGB_MATRIX_TEST_SCALE;
+                // the extra column is a black gap between frames
+                RGB pixel = {0, 0, 0};
+                if (col < MATRIX_COLS) pixel = rendering.frames[frame * DRIVER_LED_TOTAL + g_led_config.matrix_co[row][col]];
+                uint8_t rgb[3] = {pixel.r, pixel.g, pixel.b};
+                fwrite(rgb, 1, sizeof(rgb), file);
+            }
+        }
+        fclose(file);
+    }
+
+    // FNV-1a over every rendered frame, so visual changes show up in the report without looking at the images
+    static uint32_t checksum(const Rendering& rendering) {
+        uint32_t hash = 2166136261u;
+        for (const RGB& pixel : rendering.frames) {
+            for (uint8_t byte : {pixel.r, pixel.g, pixel.b}) {
+                hash = (hash ^ byte) * 16777619u;
+            }
+        }
+        return hash;
+    }
+};
+
+TEST_F(RgbMatrixEffects, SolidColorLightsEveryLed) {
+    Rendering rendering = render(RGB_MATRIX_SOLID_COLOR, 1);
+    EXPECT_EQ(rgb_matrix_mock_bad_writes, 0u);
+    EXPECT_GT(rendering.frames[0].r, 0);
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        EXPECT_NEAR(rendering.frames[i].r, rendering.frames[0].r, RGB_MATRIX_TEST_LEVEL_SLACK) << "LED " << (int)i;
+        EXPECT_NEAR(rendering.frames[i].g, rendering.frames[0].g, RGB_MATRIX_TEST_LEVEL_SLACK) << "LED " << (int)i;
+        EXPECT_NEAR(rendering.frames[i].b, rendering.frames[0].b, RGB_MATRIX_TEST_LEVEL_SLACK) << "LED " << (int)i;
+    }
+}
+
+#ifdef RGB_CURRENT_BUDGET_MA
+TEST_F(RgbMatrixEffects, StaysWithinCurrentBudget) {
+    rgb_matrix_sethsv_noeeprom(HSV_WHITE);
+    Rendering rendering = render(RGB_MATRIX_SOLID_COLOR, 2);
+    uint32_t  total     = 0;
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        const RGB& pixel = rendering.frames[DRIVER_LED_TOTAL + i];
+        total += rgb_current_of(pixel.r, pixel.g, pixel.b);
+    }
+    EXPECT_GT(total, 0u);
+    EXPECT_LE(total / 255 + DRIVER_LED_TOTAL * RGB_CURRENT_IDLE_MA, (uint32_t)RGB_CURRENT_BUDGET_MA);
+
+    // Back under the budget the frame goes out as set again, give or take the step dithering adds
+    rgb_matrix_sethsv_noeeprom(0, 255, 8);
+    rendering = render(RGB_MATRIX_SOLID_COLOR, 1);
+    RGB color = hsv_to_rgb({0, 255, 8});
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        EXPECT_NEAR(rendering.frames[i].r, color.r, 1) << "LED " << (int)i;
+    }
+}
+#endif
+
+// marching_dots.json lights every eighth of the first 16 LEDs in orange, one step further each frame, the rest of the board stays dark
+TEST_F(RgbMatrixEffects, PlaysKeyframes) {
+    Rendering rendering = render(RGB_MATRIX_CUSTOM_marching_dots, RGB_MATRIX_TEST_FRAMES);
+    EXPECT_EQ(rgb_matrix_mock_bad_writes, 0u);
+
+    bool    shown[8] = {};
+    uint8_t last     = 0;
+    for (uint16_t frame = 0; frame < RGB_MATRIX_TEST_FRAMES; frame++) {
+        const RGB* leds = &rendering.frames[frame * DRIVER_LED_TOTAL];
+        uint8_t    step = 0;
+        while (step < 8 && !leds[step].r) step++;
+        ASSERT_LT(step, 8) << "frame " << frame << " has no dot";
+        // 50ms frames are never skipped at the test's frame rate, and the animation loops
+        EXPECT_TRUE(step == last || step == (last + 1) % 8) << "frame " << frame;
+        last        = step;
+        shown[step] = true;
+
+        // scale8() to full brightness, which is one short of the authored color
+        for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+            bool lit = i < 16 && i % 8 == step;
+            EXPECT_NEAR(leds[i].r, lit ? 0xFF * UINT8_MAX / 256 : 0, RGB_MATRIX_TEST_LEVEL_SLACK) << "frame " << frame << " LED " << (int)i;
+            EXPECT_NEAR(leds[i].g, lit ? 0x40 * UINT8_MAX / 256 : 0, RGB_MATRIX_TEST_LEVEL_SLACK) << "frame " << frame << " LED " << (int)i;
+            EXPECT_EQ(leds[i].b, 0) << "frame " << frame << " LED " << (int)i;
+        }
+    }
+    for (uint8_t step = 0; step < 8; step++) {
+        EXPECT_TRUE(shown[step]) << "frame " << (int)step << " of the animation never showed";
+    }
+}
+
+// Renders every built in effect, compares it with its recorded checksum and reports what a frame costs.
+// Set RGB_MATRIX_TEST_DUMP_DIR to also get the frames as images.
+TEST_F(RgbMatrixEffects, RendersEveryEffect) {
+    const char* dump_dir = getenv("RGB_MATRIX_TEST_DUMP_DIR");
+
+    printf("%u LEDs, %u frames per effect\n", DRIVER_LED_TOTAL, RGB_MATRIX_TEST_FRAMES);
+    printf("%-32s %10s %10s %6s %10s\n", "effect", "ns/frame", "ns/LED", "tasks", "checksum");
+    for (const Effect& effect : effects) {
+        Rendering rendering = render(effect.mode, RGB_MATRIX_TEST_FRAMES);
+
+        EXPECT_EQ(rgb_matrix_mock_flushes, (uint32_t)RGB_MATRIX_TEST_FRAMES) << effect.name << " did not finish its frames";
+        EXPECT_EQ(rgb_matrix_mock_bad_writes, 0u) << effect.name << " wrote past the last LED";
+        bool lit = false;
+        for (const RGB& pixel : rendering.frames) {
+            lit |= pixel.r || pixel.g || pixel.b;
+        }
+        EXPECT_TRUE(lit) << effect.name << " never lit an LED";
+
+        uint64_t per_frame = rendering.nanoseconds / RGB_MATRIX_TEST_FRAMES;
+        uint32_t sum       = checksum(rendering);
+        printf("%-32s %10llu %10llu %6u %10x\n", effect.name, (unsigned long long)per_frame, (unsigned long long)(per_frame / DRIVER_LED_TOTAL), rendering.tasks / RGB_MATRIX_TEST_FRAMES, sum);
+#ifdef RGB_MATRIX_TEST_GOLDEN
+        const Golden* golden = find_golden(effect.name);
+        if (golden) {
+            EXPECT_EQ(sum, golden->checksum) << effect.name << " renders different frames than before";
+        } else {
+            ADD_FAILURE() << effect.name << " has no recorded checksum, add {\"" << effect.name << "\", 0x" << std::hex << sum << std::dec << "}";
+        }
+#endif
+
+        if (dump_dir) dump_strip(dump_dir, effect.name, rendering);
+    }
+}
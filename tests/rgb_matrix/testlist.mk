@@ -0,0 +1,13 @@
+# The effect tests again in other configurations, built from tests/rgb_matrix with these defines
+rgb_matrix_dither_OPT_DEFS := -DRGB_MATRIX_DITHER
+# The governor on a board with more than 128 LEDs, where it grows the per run limit past half of the board
+rgb_matrix_governor_OPT_DEFS := -DRGB_MATRIX_GOVERNOR -DRGB_MATRIX_TEST_ROWS=10 -DRGB_MATRIX_TEST_COLS=20
+# A current budget about half of what a full red board draws
+rgb_matrix_budget_OPT_DEFS := -DRGB_CURRENT_BUDGET_MA=1000
+rgb_matrix_dither_budget_OPT_DEFS := -DRGB_MATRIX_DITHER -DRGB_CURRENT_BUDGET_MA=1000
+
+RGB_MATRIX_TEST_VARIANTS := rgb_matrix_dither rgb_matrix_governor rgb_matrix_budget rgb_matrix_dither_budget
+$(foreach TEST_VARIANT,$(RGB_MATRIX_TEST_VARIANTS),$(eval $(TEST_VARIANT)_TEST_PATH := tests/rgb_matrix))
+
+TEST_LIST += $(RGB_MATRIX_TEST_VARIANTS)
+FULL_TESTS += $(RGB_MATRIX_TEST_VARIANTS)